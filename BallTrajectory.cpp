@@ -0,0 +1,16 @@
+#ifdef LOCAL
+
+#include <BallTrajectory.h>
+
+#else
+
+#include "BallTrajectory.h"
+
+#endif
+
+EntityState BallTrajectory::states[BallTrajectory::DEPTH + 1];
+int BallTrajectory::tick = -1;
+int BallTrajectory::tpt = C::TPT;
+int BallTrajectory::goal_tick = C::NEVER;
+bool BallTrajectory::goal_to_me = false;
+int BallTrajectory::on_my_side_tick = C::NEVER;
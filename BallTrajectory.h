@@ -0,0 +1,144 @@
+#ifndef CODEBALL_BALLTRAJECTORY_H
+#define CODEBALL_BALLTRAJECTORY_H
+
+#ifdef LOCAL
+#include <model/Entity.h>
+#include <model/Dan.h>
+#include <H.h>
+#else
+#include "model/Entity.h"
+#include "model/Dan.h"
+#include "H.h"
+#endif
+
+// ball-only path ignoring robots, built once per decision tick
+// simulators take it as static ball state until first robot contact
+struct BallTrajectory {
+
+  static constexpr int DEPTH = 2 * C::MAX_SIMULATION_DEPTH;
+
+  static EntityState states[DEPTH + 1];
+  static int tick;
+  static int tpt;
+
+  static int goal_tick; // first simulation tick when ball is behind goal line
+  static bool goal_to_me;
+  static int on_my_side_tick; // first simulation tick when ball z < 0
+
+  static void build(const model::Ball& _ball, const int _tpt = C::TPT) {
+    EntityState state;
+    state.position = {_ball.x, _ball.y, _ball.z};
+    state.velocity = {_ball.velocity_x, _ball.velocity_y, _ball.velocity_z};
+    state.radius = _ball.radius;
+    state.nitro = 0;
+    state.touch = false;
+    state.touch_normal = {0, 0, 0};
+    state.touch_surface_id = 0;
+    state.respawn_ticks = 0;
+    state.alive = true;
+
+    tick = H::tick;
+    tpt = _tpt;
+    goal_tick = C::NEVER;
+    goal_to_me = false;
+    on_my_side_tick = C::NEVER;
+
+    const double& goal_line = C::rules.arena.depth / 2 + C::rules.BALL_RADIUS;
+    states[0] = state;
+    for (int sim_tick = 0; sim_tick < DEPTH; ++sim_tick) {
+      if (on_my_side_tick == C::NEVER && state.position.z < -0.01) {
+        on_my_side_tick = sim_tick;
+      }
+      if (goal_tick == C::NEVER && (state.position.z > goal_line || state.position.z < -goal_line)) {
+        goal_tick = sim_tick;
+        goal_to_me = state.position.z < 0;
+      }
+      tickBall(state);
+      states[sim_tick + 1] = state;
+    }
+  }
+
+  static inline bool fits(const int& _tpt, const int& simulation_depth) {
+    return tick == H::tick && tpt == _tpt && simulation_depth < DEPTH;
+  }
+
+  static inline bool startsFrom(const EntityState& state) {
+    return states[0].position == state.position && states[0].velocity == state.velocity;
+  }
+
+  static inline bool onMySide(const int& depth) {
+    return on_my_side_tick < depth;
+  }
+
+  static inline bool goalInFuture(const int& depth, const bool to_me) {
+    return goal_tick < depth && goal_to_me == to_me;
+  }
+
+  // exact in free flight, microtick by microtick near the arena
+  static void tickBall(EntityState& state) {
+    const double& micro_dt = 1. / C::rules.TICKS_PER_SECOND / C::rules.MICROTICKS_PER_TICK;
+    int remaining_microticks = C::rules.MICROTICKS_PER_TICK * tpt;
+    while (remaining_microticks > 0) {
+      const double& dt = remaining_microticks * micro_dt;
+      const double& speed = state.velocity.length();
+      const double& reach = speed * dt + C::rules.GRAVITY * dt * dt / 2;
+      if (speed + C::rules.GRAVITY * dt < C::rules.MAX_ENTITY_SPEED
+          && state.position.y - reach > state.radius
+          && inOpenSpace(state.position, reach)) {
+        move(state, dt);
+        return;
+      }
+      move(state, micro_dt);
+      collideWithArena(state);
+      remaining_microticks--;
+    }
+  }
+
+  static inline bool inOpenSpace(const Point& position, const double& reach) {
+    return ArenaGeometry::groundOnly(position.x, position.y, position.z, reach);
+  }
+
+  static inline void move(EntityState& state, const double& delta_time) {
+    state.velocity = state.velocity.clamp(C::rules.MAX_ENTITY_SPEED);
+    state.position += state.velocity * delta_time;
+    state.position.y -= C::rules.GRAVITY * delta_time * delta_time / 2;
+    state.velocity.y -= C::rules.GRAVITY * delta_time;
+  }
+
+  // same touch rules as SmartSimulator::updateStatic
+  static inline void collideWithArena(EntityState& state) {
+    Point normal;
+    int collision_surface_id;
+    bool collided = false;
+    if (inOpenSpace(state.position, 0)) {
+      if (state.position.y < state.radius) {
+        state.position.y = state.radius;
+        if (state.velocity.y < 0) {
+          state.velocity.y -= (1. + C::rules.BALL_ARENA_E) * state.velocity.y;
+          collision_surface_id = 1;
+          collided = true;
+        }
+      }
+    } else {
+      const Dan& dan = Dan::dan_to_arena(state.position, state.radius);
+      if (state.radius > dan.distance) {
+        normal = dan.normal.normalize();
+        state.position += normal * (state.radius - dan.distance);
+        const double& velocity = state.velocity.dot(normal);
+        if (velocity < 0) {
+          state.velocity -= normal * ((1. + C::rules.BALL_ARENA_E) * velocity);
+          collision_surface_id = dan.collision_surface_id;
+          collided = true;
+        }
+      }
+    }
+    if (collided) {
+      state.touch_surface_id = collision_surface_id;
+      state.touch = true;
+    } else if (state.touch && (state.touch_surface_id != 1 || state.velocity.y > C::ball_antiflap)) {
+      state.touch = false;
+    }
+  }
+};
+
+#endif //CODEBALL_BALLTRAJECTORY_H
@@ -0,0 +1,191 @@
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+// single-file bundle of the strategy sources, for submission and for the PGO build (pgo.sh)
+// bundle [-o out.cpp] [--keep prefix]... [-D NAME]... source...
+// quoted includes of repo files are inlined in place, the path is looked up next to the including file and then
+// from the current directory (the same as -I.), includes under --keep prefixes (rapidjson/) are left as includes
+// all headers have guards or #pragma once, so every file is inlined at its first include only,
+// first includes of strategy headers sit in the #else of #ifdef LOCAL, so the bundle is built without LOCAL
+// #line directives keep compiler errors and profiles pointing to the real sources
+
+struct Bundler {
+  std::vector<std::string> keep;
+  std::set<std::string> inlined;
+  std::string out;
+
+  static bool exists(const std::string& path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+  }
+
+  // collapses "./" and "dir/../", result is relative to the current directory
+  static std::string normalize(const std::string& path) {
+    std::vector<std::string> parts;
+    size_t begin = 0;
+    while (begin <= path.size()) {
+      size_t end = path.find('/', begin);
+      if (end == std::string::npos) {
+        end = path.size();
+      }
+      const std::string& part = path.substr(begin, end - begin);
+      if (part == "..") {
+        if (!parts.empty() && parts.back() != "..") {
+          parts.pop_back();
+        } else {
+          parts.push_back(part);
+        }
+      } else if (!part.empty() && part != ".") {
+        parts.push_back(part);
+      }
+      begin = end + 1;
+    }
+    std::string result;
+    for (const auto& part : parts) {
+      result += (result.empty() ? "" : "/") + part;
+    }
+    return result;
+  }
+
+  static std::string directory(const std::string& path) {
+    const size_t& slash = path.rfind('/');
+    return slash == std::string::npos ? "" : path.substr(0, slash + 1);
+  }
+
+  // "" if the include is not a file of the repo
+  static std::string resolve(const std::string& including, const std::string& name) {
+    const std::string& local = normalize(directory(including) + name);
+    if (exists(local)) {
+      return local;
+    }
+    const std::string& root = normalize(name);
+    return exists(root) ? root : "";
+  }
+
+  // name of "#include "name"", false for any other line
+  static bool quotedInclude(const std::string& line, std::string& name) {
+    size_t i = line.find_first_not_of(" \t");
+    if (i == std::string::npos || line[i] != '#') {
+      return false;
+    }
+    i = line.find_first_not_of(" \t", i + 1);
+    if (i == std::string::npos || line.compare(i, 7, "include") != 0) {
+      return false;
+    }
+    const size_t& open = line.find('"', i + 7);
+    const size_t& close = open == std::string::npos ? open : line.find('"', open + 1);
+    if (close == std::string::npos) {
+      return false;
+    }
+    name = line.substr(open + 1, close - open - 1);
+    return true;
+  }
+
+  bool kept(const std::string& path) const {
+    for (const auto& prefix : keep) {
+      if (path.compare(0, prefix.size(), prefix) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool add(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+      fprintf(stderr, "cannot open %s\n", path.c_str());
+      return false;
+    }
+    inlined.insert(path);
+    out += "#line 1 \"" + path + "\"\n";
+    std::string line, name;
+    int line_number = 0;
+    while (std::getline(in, line)) {
+      line_number++;
+      if (line.compare(0, 12, "#pragma once") == 0) {
+        out += "\n";
+        continue;
+      }
+      if (!quotedInclude(line, name)) {
+        out += line + "\n";
+        continue;
+      }
+      const std::string& included = resolve(path, name);
+      if (included.empty()) {
+        out += line + "\n";
+      } else if (kept(included)) {
+        out += "#include \"" + included + "\"\n";
+      } else if (inlined.count(included)) {
+        out += "\n";
+      } else {
+        if (!add(included)) {
+          return false;
+        }
+        out += "#line " + std::to_string(line_number + 1) + " \"" + path + "\"\n";
+      }
+    }
+    return true;
+  }
+};
+
+static void usage(const char* name) {
+  fprintf(stderr, "usage: %s [-o out.cpp] [--keep prefix]... [-D NAME]... source...\n", name);
+  exit(1);
+}
+
+int main(int argc, char* argv[]) {
+  Bundler bundler;
+  std::string output, defines;
+  std::vector<std::string> sources;
+  for (int i = 1; i < argc; ++i) {
+    const std::string& arg = argv[i];
+    auto value = [&]() {
+      if (i + 1 >= argc) {
+        usage(argv[0]);
+      }
+      return std::string(argv[++i]);
+    };
+    if (arg == "-o") {
+      output = value();
+    } else if (arg == "--keep") {
+      bundler.keep.push_back(value());
+    } else if (arg == "-D") {
+      defines += "#define " + value() + " 1\n";
+    } else if (!arg.empty() && arg[0] == '-') {
+      usage(argv[0]);
+    } else {
+      sources.push_back(Bundler::normalize(arg));
+    }
+  }
+  if (sources.empty()) {
+    usage(argv[0]);
+  }
+
+  bundler.out = "// generated by bundle from";
+  for (const auto& source : sources) {
+    bundler.out += " " + source;
+  }
+  bundler.out += ", do not edit\n" + defines;
+  for (const auto& source : sources) {
+    if (!bundler.inlined.count(source) && !bundler.add(source)) {
+      return 1;
+    }
+  }
+
+  FILE* f = output.empty() ? stdout : fopen(output.c_str(), "w");
+  if (!f) {
+    fprintf(stderr, "cannot open %s\n", output.c_str());
+    return 1;
+  }
+  fwrite(bundler.out.data(), 1, bundler.out.size(), f);
+  if (f != stdout) {
+    fclose(f);
+  }
+  return 0;
+}
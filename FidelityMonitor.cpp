@@ -0,0 +1,110 @@
+#ifdef LOCAL
+
+#include <FidelityMonitor.h>
+
+#else
+
+#include "FidelityMonitor.h"
+
+#endif
+
+constexpr int FidelityMonitor::trigger_limits[FidelityMonitor::LEVELS];
+FidelityMonitor::Prediction FidelityMonitor::predictions[FidelityMonitor::LEVELS];
+int FidelityMonitor::situations[7];
+double FidelityMonitor::errors[FidelityMonitor::LEVELS][FidelityMonitor::TYPES][FidelityMonitor::SITUATIONS];
+int FidelityMonitor::samples[FidelityMonitor::TYPES][FidelityMonitor::SITUATIONS];
+int FidelityMonitor::level = 1;
+
+void FidelityMonitor::check() {
+  if (predictions[0].tick == H::tick) {
+    Point observed[7];
+    bool is_teammate[7];
+    for (auto& robot : H::game.robots) {
+      const int& id = H::getRobotLocalIdByGlobal(robot.id);
+      observed[id] = {robot.x, robot.y, robot.z};
+      is_teammate[id] = robot.is_teammate;
+    }
+    observed[6] = {H::game.ball.x, H::game.ball.y, H::game.ball.z};
+    for (int i = 0; i < 7; ++i) {
+      if (i >= H::team_size * 2 && i < 6) {
+        continue;
+      }
+      const int& type = i == 6 ? 0 : (is_teammate[i] ? 1 : 2);
+      const int& situation = situations[i];
+      const bool& first = samples[type][situation] == 0;
+      for (int level = 0; level < LEVELS; ++level) {
+        const auto& predicted = i == 6 ? predictions[level].ball : predictions[level].robots[i];
+        const double& error = (predicted.position - observed[i]).length();
+        auto& mean = errors[level][type][situation];
+        mean = first ? error : mean + C::FIDELITY_MONITOR_RATE * (error - mean);
+      }
+      samples[type][situation]++;
+    }
+  }
+  choose();
+  H::fidelity_ticks[level]++;
+}
+
+void FidelityMonitor::choose() {
+  // enemy errors come from their unknown actions, ball and my robots show the simulator itself
+  if (samples[0][1] < C::FIDELITY_MIN_SAMPLES || samples[1][1] < C::FIDELITY_MIN_SAMPLES) {
+    level = 1;
+    return;
+  }
+  double error[LEVELS];
+  double best = 1e9;
+  for (int i = 0; i < LEVELS; ++i) {
+    error[i] = errors[i][0][1] + errors[i][1][1];
+    best = std::min(best, error[i]);
+  }
+  level = 0;
+  while (error[level] > best + C::FIDELITY_TOLERANCE) {
+    level++;
+  }
+}
+
+void FidelityMonitor::predict() {
+  const int trigger_limit = H::trigger_limit;
+  for (int level = 0; level < LEVELS; ++level) {
+    H::trigger_limit = trigger_limits[level];
+    SmartSimulator simulator(false, C::TPT, 1, H::getRobotGlobalIdByLocal(0), 2, H::game.robots, H::game.ball, H::game.nitro_packs);
+    simulator.initIteration(0, H::best_plan[0]);
+    simulator.tickDynamic(0);
+    auto& prediction = predictions[level];
+    prediction.tick = H::tick + C::TPT;
+    prediction.ball = simulator.ball->is_dynamic ? simulator.ball->state : simulator.ball->states[1];
+    prediction.robots[0] = simulator.main_robot->state;
+    for (int i = 0; i < simulator.initial_static_robots_size; ++i) {
+      const auto& e = simulator.initial_static_robots[i];
+      prediction.robots[H::getRobotLocalIdByGlobal(e->id)] = e->is_dynamic ? e->state : e->states[1];
+    }
+  }
+  H::trigger_limit = trigger_limit;
+
+  // contact is possible if entities can meet during the step with the current relative velocity
+  Entity entities[7];
+  for (auto& robot : H::game.robots) {
+    entities[H::getRobotLocalIdByGlobal(robot.id)].fromRobot(robot);
+  }
+  entities[6].fromBall(H::game.ball);
+  const double& dt = (double) C::TPT / C::rules.TICKS_PER_SECOND;
+  for (int i = 0; i < 7; ++i) {
+    situations[i] = 0;
+  }
+  for (int i = 0; i < 7; ++i) {
+    if (i >= H::team_size * 2 && i < 6) {
+      continue;
+    }
+    for (int j = i + 1; j < 7; ++j) {
+      if (j >= H::team_size * 2 && j < 6) {
+        continue;
+      }
+      const auto& a = entities[i].state;
+      const auto& b = entities[j].state;
+      const double& reach = a.radius + b.radius + (a.velocity - b.velocity).length() * dt + 0.5;
+      if ((a.position - b.position).length_sq() < reach * reach) {
+        situations[i] = situations[j] = 1;
+      }
+    }
+  }
+}
@@ -0,0 +1,43 @@
+#ifndef CODEBALL_FIDELITYMONITOR_H
+#define CODEBALL_FIDELITYMONITOR_H
+
+#ifdef LOCAL
+#include <SmartSimulator.h>
+#else
+#include "SmartSimulator.h"
+#endif
+
+// every decision tick one step of the simulator is made for each fidelity level, at the next decision tick
+// predicted positions of the ball and robots are checked against the game, running errors are kept per entity type
+// and situation, the cheapest level with the error of the best one is used by the search simulators (H::trigger_limit)
+struct FidelityMonitor {
+
+  static constexpr int LEVELS = 3;
+  static constexpr int TYPES = 3; // ball, my robot, enemy robot
+  static constexpr int SITUATIONS = 2; // 0 - nothing to collide with during the step, 1 - contact possible
+
+  // trigger fires of every kind allowed per tick, 2 is the default of SmartSimulator, 0 misses most ball contacts
+  static constexpr int trigger_limits[LEVELS] = {1, 2, 8};
+
+  struct Prediction {
+    int tick = -1; // decision tick the prediction is for
+    EntityState ball;
+    EntityState robots[6]; // by local id
+  };
+
+  static Prediction predictions[LEVELS];
+  static int situations[7]; // robots by local id, 6 - ball
+  static double errors[LEVELS][TYPES][SITUATIONS]; // running mean of position error
+  static int samples[TYPES][SITUATIONS];
+  static int level;
+
+  // at the beginning of decision tick, updates errors and level
+  static void check();
+
+  // at the end of decision tick, after best plans are chosen
+  static void predict();
+
+  static void choose();
+};
+
+#endif //CODEBALL_FIDELITYMONITOR_H
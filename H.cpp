@@ -8,6 +8,11 @@
 
 #endif
 
+#include <cstdlib>
+#include <cstring>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 model::Game H::game;
 
@@ -16,12 +21,12 @@ int H::tick = -1;
 model::Action H::actions[7];
 int H::global_id;
 int H::my_id;
+int H::trigger_limit = 2;
+int H::team_size = 3;
 Plan H::best_plan[6];
 Plan H::last_action_plan[6];
 Plan H::last_action0_plan[6];
 
-MyTimer H::t[100];
-MyTimer H::c[100];
 MyTimer H::global_timer;
 MyTimer H::cur_tick_timer;
 int H::player_score[2];
@@ -32,48 +37,78 @@ double H::min_iterations = 1e9;
 double H::max_iterations = 0;
 double H::sum_iterations = 0;
 double H::iterations_k = 0;
+long long H::search_iterations = 0;
+long long H::jump_ticks[2];
+long long H::jump_rollbacks[2];
+long long H::predicted_jumps[2];
+long long H::island_simulators = 0;
+long long H::sum_islands = 0;
+long long H::sum_max_island_size = 0;
+long long H::screening_batches = 0;
+long long H::screening_top_misses = 0;
+long long H::screening_pairs = 0;
+long long H::screening_inversions = 0;
+long long H::joint_ticks = 0;
+long long H::joint_rounds = 0;
+long long H::joint_converged = 0;
+long long H::evaluation_lookups = 0;
+long long H::evaluation_hits = 0;
+long long H::opponent_predictions = 0;
+long long H::opponent_model_predictions = 0;
+long long H::fidelity_ticks[3];
 Point H::prev_velocity[7];
 Point H::prev_position[7];
-int H::danger_grid[60][20][100][C::MAX_SIMULATION_DEPTH];
-DGState H::used_cells[1000007];
+uint16_t (*H::danger_grid)[20][100][C::ENEMY_SIMULATION_DEPTH] = nullptr;
+DGState* H::used_cells = nullptr;
+PlanEvaluation* H::evaluation_cache = nullptr;
 int H::used_cells_size = 0;
 
 std::map<int, int> H::best_plan_type;
 
 
 H::ROLE H::role[6];
-bool H::flag;
+int H::acts;
+bool H::deterministic = false;
 
 Point2d H::prev_last_action[6];
 
-#ifndef LOCAL
-namespace Frozen {
-
-model::Game H::game;
-
-int H::tick = -1;
-model::Action H::actions[7];
-int H::global_id;
-int H::my_id;
-Plan H::best_plan[6];
-Plan H::last_action_plan[6];
-
-MyTimer H::t[100];
-MyTimer H::c[100];
-MyTimer H::global_timer;
-int H::player_score[2];
-int H::waiting_ticks;
-double H::time_limit;
-double H::half_time;
-double H::sum_asserts_failed = 0;
-double H::asserts_failed_k = 0;
-Point H::prev_velocity[7];
-Point H::prev_position[7];
-int H::danger_grid[80][20][60][100];
-DGState H::used_cells[1000007];
-int H::used_cells_size = 0;
+#ifdef SPECULATIVE
+std::thread H::spec_worker;
+std::atomic<bool> H::spec_stop;
+double H::spec_cpu_time = 0;
+int H::spec_tick = -1;
+int H::spec_robots = 0;
+model::Game H::spec_game;
+Plan H::spec_best_plan[3];
+int H::spec_iterations[3];
+H::ROLE H::spec_role[3];
+#endif
 
-Point2d H::prev_last_action[6];
+// zeroed memory with every page already faulted in, huge pages are only a hint
+static void* allocateTouched(const size_t& size) {
+  void* ptr = nullptr;
+#ifdef __linux__
+  ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (ptr == MAP_FAILED) {
+    ptr = nullptr;
+  } else {
+    madvise(ptr, size, MADV_HUGEPAGE);
+  }
+#endif
+  if (!ptr) {
+    ptr = std::malloc(size);
+  }
+  std::memset(ptr, 0, size);
+  return ptr;
+}
 
+void H::warmUp() {
+  if (danger_grid) {
+    return;
+  }
+  danger_grid = static_cast<decltype(danger_grid)>(allocateTouched(sizeof(*danger_grid) * 60));
+  used_cells = static_cast<DGState*>(allocateTouched(sizeof(DGState) * USED_CELLS_CAPACITY));
+#ifdef EVAL_CACHE
+  evaluation_cache = static_cast<PlanEvaluation*>(allocateTouched(sizeof(PlanEvaluation) * C::EVAL_CACHE_SIZE));
+#endif
 }
-#endif
\ No newline at end of file
@@ -4,9 +4,17 @@
 #ifdef LOCAL
 #include <model/C.h>
 #include <model/Plan.h>
+#include <model/ArenaGeometry.h>
 #else
 #include "model/C.h"
 #include "model/Plan.h"
+#include "model/ArenaGeometry.h"
+#endif
+
+#include <cstdio>
+#ifdef SPECULATIVE
+#include <atomic>
+#include <thread>
 #endif
 
 
@@ -18,6 +26,8 @@ struct H {
   static model::Action actions[7];
   static int global_id;
   static int my_id;
+  static int trigger_limit; // trigger fires per tick of new simulators, ADAPTIVE_FIDELITY changes it
+  static int team_size; // robots per team, local ids are [0, team_size) for mine and [team_size, 2 * team_size) for enemies
 
   static Point2d prev_last_action[6];
   static Plan last_best_plan[6];
@@ -33,10 +43,47 @@ struct H {
   static double max_iterations;
   static double sum_iterations;
   static double iterations_k;
-
-  static int danger_grid[60][20][100][C::MAX_SIMULATION_DEPTH];
-  static DGState used_cells[1000007];
+  static long long search_iterations; // since start, not reset on goals, replay --timed reads it
+
+  // jump rollbacks, 0 - static precompute, 1 - dynamic simulation
+  static long long jump_ticks[2];
+  static long long jump_rollbacks[2];
+  static long long predicted_jumps[2];
+
+  // interaction islands of static precompute
+  static long long island_simulators;
+  static long long sum_islands;
+  static long long sum_max_island_size;
+
+  // multi-fidelity screening: batches, batches where coarse best is not fine best, pairs of top-K in other order
+  static long long screening_batches;
+  static long long screening_top_misses;
+  static long long screening_pairs;
+  static long long screening_inversions;
+
+  // joint planning: ticks, sum of rounds, ticks where the last round changed no best plan
+  static long long joint_ticks;
+  static long long joint_rounds;
+  static long long joint_converged;
+
+  // evaluation cache: lookups and hits of evaluateMinimax results
+  static long long evaluation_lookups;
+  static long long evaluation_hits;
+  static long long opponent_predictions;
+  static long long opponent_model_predictions;
+  static long long fidelity_ticks[3];
+
+  // enemies * iterations * cells per tick * ticks of predictEnemies, upper bound of distinct cells
+  static constexpr int USED_CELLS_CAPACITY = 3 * 100 * 6 * C::ENEMY_SIMULATION_DEPTH;
+
+  // allocated and touched by warmUp before the first tick, counters fit in 16 bits with USED_CELLS_CAPACITY adds
+  static uint16_t (*danger_grid)[20][100][C::ENEMY_SIMULATION_DEPTH];
+  static DGState* used_cells;
   static int used_cells_size;
+  static PlanEvaluation* evaluation_cache; // C::EVAL_CACHE_SIZE entries, EVAL_CACHE only
+
+  // page faults of big buffers go here instead of the first timed decision
+  static void warmUp();
 
   static Point prev_velocity[7];
   static Point prev_position[7];
@@ -46,7 +93,116 @@ struct H {
 
   static ROLE role[6];
 
-  static bool flag;
+  static int acts; // acts of the current tick, tryInit returns 3 for the last one (team_size)
+
+  // replay checks: fixed iteration counts per role instead of time limits, no speculation
+  static bool deterministic;
+
+#ifdef SPECULATIVE
+  // search for the next decision tick from predicted state, runs while we wait for the server
+  static std::thread spec_worker;
+  static std::atomic<bool> spec_stop;
+  static double spec_cpu_time;
+  static int spec_tick; // decision tick which speculative results are for, -1 if none
+  static int spec_robots; // results are only for local ids below it, the worker may be stopped before the rest
+  static model::Game spec_game;
+  static Plan spec_best_plan[3];
+  static int spec_iterations[3];
+  static ROLE spec_role[3];
+#endif
+
+  static inline void addIslandStats(const int& islands_count, const int& max_island_size) {
+    island_simulators++;
+    sum_islands += islands_count;
+    sum_max_island_size += max_island_size;
+  }
+
+  // average islands count and max island size per simulator
+  static std::string islandStats() {
+    const double& simulators = std::max(1LL, island_simulators);
+    char result[64];
+    snprintf(result, sizeof(result), "isl %.2f/%.2f", sum_islands / simulators, sum_max_island_size / simulators);
+    island_simulators = sum_islands = sum_max_island_size = 0;
+    return result;
+  }
+
+  // percent of screening batches with other best plan and percent of top-K pairs in other order, empty if no screening
+  static std::string screeningStats() {
+    if (screening_batches == 0) {
+      return "";
+    }
+    char result[64];
+    snprintf(result, sizeof(result), " scr %d/%d%%",
+             int(100. * screening_top_misses / screening_batches),
+             int(100. * screening_inversions / std::max(1LL, screening_pairs)));
+    screening_batches = screening_top_misses = screening_pairs = screening_inversions = 0;
+    return result;
+  }
+
+  static void addJointStats(const int& rounds, const bool& converged) {
+    joint_ticks++;
+    joint_rounds += rounds;
+    joint_converged += converged;
+  }
+
+  // average rounds of joint planning and percent of converged ticks, empty if no joint planning
+  static std::string jointStats() {
+    if (joint_ticks == 0) {
+      return "";
+    }
+    char result[64];
+    snprintf(result, sizeof(result), " jnt %.2f/%d%%",
+             (double) joint_rounds / joint_ticks, int(100. * joint_converged / joint_ticks));
+    joint_ticks = joint_rounds = joint_converged = 0;
+    return result;
+  }
+
+  // percent of evaluations taken from evaluation cache, empty if no cache
+  static std::string evaluationCacheStats() {
+    if (evaluation_lookups == 0) {
+      return "";
+    }
+    char result[64];
+    snprintf(result, sizeof(result), " evc %.1f%%", 100. * evaluation_hits / evaluation_lookups);
+    evaluation_lookups = evaluation_hits = 0;
+    return result;
+  }
+
+  // percent of enemy last action plans replaced by opponent model, empty if no model
+  static std::string opponentModelStats() {
+    if (opponent_predictions == 0) {
+      return "";
+    }
+    char result[64];
+    snprintf(result, sizeof(result), " opm %d%%", int(100. * opponent_model_predictions / opponent_predictions));
+    opponent_predictions = opponent_model_predictions = 0;
+    return result;
+  }
+
+  // percent of decision ticks on every fidelity level, empty if no adaptive fidelity
+  static std::string fidelityStats() {
+    const long long& ticks = fidelity_ticks[0] + fidelity_ticks[1] + fidelity_ticks[2];
+    if (ticks == 0) {
+      return "";
+    }
+    char result[64];
+    snprintf(result, sizeof(result), " fid %d/%d/%d%%", int(100. * fidelity_ticks[0] / ticks),
+             int(100. * fidelity_ticks[1] / ticks), int(100. * fidelity_ticks[2] / ticks));
+    fidelity_ticks[0] = fidelity_ticks[1] = fidelity_ticks[2] = 0;
+    return result;
+  }
+
+  // percent of ticks with rollback (and predicted instead) for static and dynamic simulation
+  static std::string rollbackStats() {
+    std::string result;
+    for (int i = 0; i < 2; ++i) {
+      const double& ticks = std::max(1LL, jump_ticks[i]);
+      result += (i == 0 ? "rb s " : " d ") + std::to_string(int(100. * jump_rollbacks[i] / ticks))
+          + "/" + std::to_string(int(100. * predicted_jumps[i] / ticks)) + "%";
+      jump_ticks[i] = jump_rollbacks[i] = predicted_jumps[i] = 0;
+    }
+    return result;
+  }
 
   static int tryInit(
       const model::Robot& _me,
@@ -54,11 +210,7 @@ struct H {
       const model::Game& _game) {
     global_id = _me.id;
     if (tick == _game.current_tick) {
-      if (!flag) {
-        flag = true;
-        return 2;
-      }
-      return 3;
+      return ++acts < team_size ? 2 : 3;
     }
     H::global_timer.start();
     game = _game;
@@ -78,10 +230,12 @@ struct H {
           break;
         }
       }
+      team_size = _rules.team_size;
       player_score[0] = player_score[1] = 0;
       waiting_ticks = 0;
       cur_round_tick = 0;
       C::rd.seed(229);
+      ArenaGeometry::build(C::rules.arena, {C::rules.ROBOT_MAX_RADIUS, C::rules.BALL_RADIUS});
     }
     bool output = false;
     for (auto& player : game.players) {
@@ -95,10 +249,14 @@ struct H {
       cur_round_tick = -119;
       if (player_score[0] + player_score[1] < 8) {
         std::cout << int(sum_iterations / iterations_k) << " "
-                  << int(min_iterations) << " " << int(max_iterations) << "\n";
+                  << int(min_iterations) << " " << int(max_iterations) << " "
+                  << rollbackStats() << " " << islandStats() << screeningStats() << jointStats() << evaluationCacheStats()
+                  << opponentModelStats() << fidelityStats() << "\n";
       } else {
         std::cerr << int(sum_iterations / iterations_k) << " "
-                  << int(min_iterations) << " " << int(max_iterations) << "\n";
+                  << int(min_iterations) << " " << int(max_iterations) << " "
+                  << rollbackStats() << " " << islandStats() << screeningStats() << jointStats() << evaluationCacheStats()
+                  << opponentModelStats() << fidelityStats() << "\n";
       }
       min_iterations = 1e9;
       max_iterations = 0;
@@ -107,6 +265,7 @@ struct H {
     }
     if (waiting_ticks > 0) {
       waiting_ticks--;
+      acts = team_size;
       return 3;
     }
     double time_per_tick = C::time_limit / 9000.;
@@ -118,7 +277,7 @@ struct H {
     cur_tick_remaining_time = std::min(10., (time_end_balance - global_timer.getCumulative()) / half_ticks_remaining);
     //cur_tick_remaining_time = (C::time_limit - global_timer.getCumulative(true)) / ((18000 - (double)tick) / 2);
 
-    flag = false;
+    acts = 1;
     return 1;
   }
 
@@ -129,20 +288,20 @@ struct H {
   static int getRobotGlobalIdByLocal(int id) {
     if (my_id == 1) {
       return id + 1;
-    } else if (id < 3) {
-      return id + 4;
+    } else if (id < team_size) {
+      return id + team_size + 1;
     } else {
-      return id - 2;
+      return id - team_size + 1;
     }
   }
 
   static int getRobotLocalIdByGlobal(int id) {
     if (my_id == 1) {
       return id - 1;
-    } else if (id <= 3) {
-      return id + 2;
+    } else if (id <= team_size) {
+      return id + team_size - 1;
     } else {
-      return id - 4;
+      return id - team_size - 1;
     }
   }
 
@@ -218,196 +377,8 @@ struct H {
 
   }
 
-  static MyTimer t[100];
-  static MyTimer c[100];
   static MyTimer global_timer;
   static MyTimer cur_tick_timer;
 };
 
-#ifndef LOCAL
-namespace Frozen {
-
-struct H {
-  static model::Game game;
-
-  static int tick;
-  static model::Action actions[7];
-  static int global_id;
-  static int my_id;
-
-  static Point2d prev_last_action[6];
-  static Plan last_best_plan[6];
-  static Plan best_plan[6];
-  static Plan last_action_plan[6];
-  static int player_score[2];
-  static int waiting_ticks;
-  static double time_limit;
-  static double half_time;
-
-  static double sum_asserts_failed;
-  static double asserts_failed_k;
-
-  static int danger_grid[80][20][60][100];
-  static DGState used_cells[1000007];
-  static int used_cells_size;
-
-  static Point prev_velocity[7];
-  static Point prev_position[7];
-
-  static bool tryInit(
-      const model::Robot& _me,
-      const model::Rules& _rules,
-      const model::Game& _game) {
-    global_id = _me.id;
-    if (tick == _game.current_tick) {
-      return false;
-    }
-    H::global_timer.start();
-    game = _game;
-    std::sort(game.robots.begin(), game.robots.end(), [](const auto& a, const auto& b) {
-      return a.id < b.id;
-    });
-    C::rules = _rules;
-    tick = game.current_tick;
-    actions[1] = actions[2] = actions[3] = actions[4] = model::Action();
-    if (tick == 0) { // init on tick 0
-      for (auto& player : game.players) {
-        if (player.me) {
-          my_id = player.id;
-          break;
-        }
-      }
-      player_score[0] = player_score[1] = 0;
-      waiting_ticks = 0;
-      C::rd.seed(229);
-    }
-    for (auto& player : game.players) {
-      if (player_score[player.id - 1] != player.score) {
-        player_score[player.id - 1] = player.score;
-        waiting_ticks = 119;
-        std::cout << int(sum_asserts_failed / asserts_failed_k) << " ?_?" << std::endl;
-      }
-    }
-    if (waiting_ticks > 0) {
-      waiting_ticks--;
-      return false;
-    }
-    double time_per_tick = C::time_limit / 18000.;
-    double ticks_remaining = (18000 - tick);
-    double half_ticks_remaining = ticks_remaining / 50.;
-    double tick_end_balance = tick + half_ticks_remaining;
-    double time_end_balance = C::time_limit - time_per_tick * (ticks_remaining - half_ticks_remaining);
-
-    half_time = (time_end_balance - global_timer.getCumulative()) / half_ticks_remaining / 2;
-    //std::cout << "time: " << std::fixed << std::setprecision(3) << half_time * 2000 << std::endl;
-    time_limit = global_timer.getCumulative() + half_time * 2;
-    //std::cout << "time_limit: " << std::fixed << std::setprecision(3) << time_limit << std::endl;
-    //std::cout << "global_timer: " << std::fixed << std::setprecision(3) <<  global_timer.getCumulative() << std::endl;
-    half_time = global_timer.getCumulative() + half_time;
-    return true;
-  }
-
-  static model::Action getCurrentAction() {
-    return actions[global_id];
-  }
-
-  static int getRobotGlobalIdByLocal(int id) {
-    if (my_id == 1) {
-      return id + 1;
-    } else if (id < 2) {
-      return id + 3;
-    } else {
-      return id - 1;
-    }
-  }
-
-  static int getRobotLocalIdByGlobal(int id) {
-    if (my_id == 1) {
-      return id - 1;
-    } else if (id <= 2) {
-      return id + 1;
-    } else {
-      return id - 3;
-    }
-  }
-
-  static bool solve(double v0x, double v0z, double v1x, double v1z, double dvx, double dvz, double& ax, double& az) {
-    const double eps = 1e-9;
-    if (dvx * dvx + dvz * dvz < eps) {
-      ax = v1x;
-      az = v1z;
-      return true;
-    }
-    double c = v0x * dvz - v0z * dvx;
-    double D = 4 * dvz * dvz * c * c - 4 * (dvx * dvx + dvz * dvz) * (c * c - 900 * dvx * dvx);
-    if (D >= 0) {
-      double x1 = (2 * dvz * c + sqrt(D)) / (2 * (dvx * dvx + dvz * dvz));
-      double x2 = (2 * dvz * c - sqrt(D)) / (2 * (dvx * dvx + dvz * dvz));
-      double y1 = 900 - x1 * x1;
-      double y2 = 900 - x2 * x2;
-
-      if (y1 >= 0) {
-        y1 = sqrt(y1);
-        if (dvz * x1 - c < 0) {
-          y1 = -y1;
-        }
-        if (fabs((x1 - v0x) * dvz - (y1 - v0z) * dvx) < eps) {
-          ax = x1;
-          az = y1;
-          return true;
-        }
-      }
-
-      if (y2 >= 0) {
-        y2 = sqrt(y2);
-        if (dvz * x2 - c > 0) {
-          y2 = -y2;
-        }
-        if (fabs((x2 - v0x) * dvz - (y2 - v0z) * dvx) < eps) {
-          ax = x2;
-          az = y2;
-          return true;
-        }
-      }
-
-    }
-    return false;
-  }
-
-  template<typename T>
-  static int sgn(T val) {
-    return (T(0) < val) - (val < T(0));
-  }
-
-  static bool solve2(Point2d v11, Point2d v12, Point2d v21, Point2d v22, Point& crossing) {
-
-    Point2d cut1 = v12 - v11;
-    Point2d cut2 = v22 - v21;
-
-    double z1 = cut1.x * (v21 - v11).y - cut1.y * (v21 - v11).x;
-    double z2 = cut1.x * (v22 - v11).y - cut1.y * (v22 - v11).x;
-
-    if (sgn(z1) == sgn(z2) || (z1 == 0) || (z2 == 0)) // Отсекаем также и пограничные случаи
-      return false;
-
-    z1 = cut2.x * (v11 - v21).y - cut2.y * (v11 - v21).x;
-    z2 = cut2.x * (v12 - v21).y - cut2.y * (v12 - v21).x;
-
-    if (sgn(z1) == sgn(z2) || (z1 == 0) || (z2 == 0)) // Отсекаем также и пограничные случаи
-      return false;
-
-    crossing.x = v11.x + cut1.x * fabs(z1) / fabs(z2 - z1);
-    crossing.z = v11.y + cut1.y * fabs(z1) / fabs(z2 - z1);
-
-    return true;
-
-  }
-
-  static MyTimer t[100];
-  static MyTimer c[100];
-  static MyTimer global_timer;
-};
-
-}
-#endif
 #endif //CODEBALL_HELPER_H
@@ -0,0 +1,158 @@
+#ifndef CODEBALL_ISLANDS_H
+#define CODEBALL_ISLANDS_H
+
+#ifdef LOCAL
+#include <model/Entity.h>
+#else
+#include "model/Entity.h"
+#endif
+
+#include <bitset>
+
+// interaction islands of static precompute
+// entities are linked by ticks of their contacts, island = connected component
+// entity woken on tick t wakes island neighbours on their first contact tick >= t, every entity settles once
+// also marks ticks when somebody wakes or dies, so simulator touches its arrays only on changes
+struct Islands {
+
+  static constexpr int MAX_ENTITIES = 7; // ball and robots, id is index
+  static constexpr int MAX_TICKS = C::MAX_SIMULATION_DEPTH + 2;
+
+  Entity* entities[MAX_ENTITIES];
+  std::bitset<MAX_TICKS> contacts[MAX_ENTITIES][MAX_ENTITIES];
+  int neighbours[MAX_ENTITIES]; // mask of ids with any contact
+  int parent[MAX_ENTITIES];
+
+  bool wake_on_tick[MAX_TICKS]; // somebody wants to become dynamic on tick, current iteration
+  unsigned int sleep_mask[MAX_TICKS]; // static entity indexes which die on tick, same for all iterations
+
+  void clear() {
+    for (int i = 0; i < MAX_ENTITIES; ++i) {
+      entities[i] = 0;
+      neighbours[i] = 0;
+      parent[i] = i;
+      for (int j = 0; j < MAX_ENTITIES; ++j) {
+        contacts[i][j].reset();
+      }
+    }
+    for (int i = 0; i < MAX_TICKS; ++i) {
+      wake_on_tick[i] = false;
+      sleep_mask[i] = 0;
+    }
+  }
+
+  inline void addEntity(Entity* e) {
+    if (e->id < MAX_ENTITIES) {
+      entities[e->id] = e;
+    }
+  }
+
+  inline int find(int id) {
+    while (parent[id] != id) {
+      parent[id] = parent[parent[id]];
+      id = parent[id];
+    }
+    return id;
+  }
+
+  inline void addContact(const int& a, const int& b, const int& tick) {
+    if (!entities[a] || !entities[b]) {
+      return;
+    }
+    contacts[a][b].set(tick);
+    contacts[b][a].set(tick);
+    neighbours[a] |= 1 << b;
+    neighbours[b] |= 1 << a;
+    parent[find(a)] = find(b);
+  }
+
+  // removal tick = first tick where entity state pointer looks at dead state
+  inline void addSleep(const int& index, const int& tick) {
+    if (tick >= 0 && tick < MAX_TICKS) {
+      sleep_mask[tick] |= 1u << index;
+    }
+  }
+
+  inline void clearWakes() {
+    for (int i = 0; i < MAX_TICKS; ++i) {
+      wake_on_tick[i] = false;
+    }
+  }
+
+  inline int firstContact(const int& a, const int& b, const int& tick) const {
+    for (int t = tick; t < MAX_TICKS; ++t) {
+      if (contacts[a][b][t]) {
+        return t;
+      }
+    }
+    return C::NEVER;
+  }
+
+  // earliest wake tick propagation, only entities which start to want earlier go further
+  void wake(Entity* e, const int& tick) {
+    if (e->id >= MAX_ENTITIES || entities[e->id] != e) {
+      wantToBecomeDynamic(e, tick);
+      return;
+    }
+    int arrival[MAX_ENTITIES];
+    for (int i = 0; i < MAX_ENTITIES; ++i) {
+      arrival[i] = C::NEVER;
+    }
+    arrival[e->id] = tick;
+    int settled = 0;
+    while (true) {
+      int cur = -1;
+      for (int i = 0; i < MAX_ENTITIES; ++i) {
+        if (!(settled & (1 << i)) && arrival[i] != C::NEVER && (cur == -1 || arrival[i] < arrival[cur])) {
+          cur = i;
+        }
+      }
+      if (cur == -1) {
+        break;
+      }
+      settled |= 1 << cur;
+      const auto& cur_entity = entities[cur];
+      if (cur != e->id && cur_entity->want_to_become_dynamic
+          && cur_entity->want_to_become_dynamic_on_tick <= arrival[cur]) {
+        continue; // its cascade is already done
+      }
+      wantToBecomeDynamic(cur_entity, arrival[cur]);
+      for (int i = 0; i < MAX_ENTITIES; ++i) {
+        if ((neighbours[cur] & (1 << i)) && !(settled & (1 << i))) {
+          const int& contact_tick = firstContact(cur, i, arrival[cur]);
+          if (contact_tick < arrival[i]) {
+            arrival[i] = contact_tick;
+          }
+        }
+      }
+    }
+  }
+
+  inline void wantToBecomeDynamic(Entity* e, const int& tick) {
+    e->want_to_become_dynamic = true;
+    e->want_to_become_dynamic_on_tick = tick;
+    if (tick < MAX_TICKS) {
+      wake_on_tick[tick] = true;
+    }
+  }
+
+  // islands with more than one entity: count and max size
+  void stats(int& islands_count, int& max_island_size) {
+    int size[MAX_ENTITIES] = {0};
+    for (int i = 0; i < MAX_ENTITIES; ++i) {
+      if (entities[i]) {
+        size[find(i)]++;
+      }
+    }
+    islands_count = 0;
+    max_island_size = 0;
+    for (int i = 0; i < MAX_ENTITIES; ++i) {
+      if (size[i] > 1) {
+        islands_count++;
+        max_island_size = std::max(max_island_size, size[i]);
+      }
+    }
+  }
+};
+
+#endif //CODEBALL_ISLANDS_H
@@ -0,0 +1,413 @@
+#include <sched.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "LocalWorld.h"
+
+// stand-in for the official local runner: same line protocol, no visualizer
+// json, token -> rules -> game, actions|rendering, <end> -> ... -> connection closed at the end
+// bots are started by the server when commands are given, summary is one json line on stdout
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string command[2];
+  int port[2] = {31001, 31002};
+  int core[2] = {-1, -1}; // cpu for bot process, -1 - any
+  int team_size = 3;
+  int ticks = 18000;
+  long long seed = 229;
+  bool nitro = true;
+  int tick_timeout_ms = 0; // 0 - wait forever
+  int connect_timeout_ms = 30000;
+  bool quiet = false;
+};
+
+struct Connection {
+  int listen_fd = -1;
+  int fd = -1;
+  pid_t pid = -1;
+  std::string buffer;
+  bool crashed = false;
+  bool timed_out = false;
+  int timeouts = 0;
+  double latency_sum = 0;
+  double latency_max = 0;
+  long long responses = 0;
+  double cpu_time = 0;
+  std::string reply; // first line of the reply to the current tick, actions|rendering
+
+  // false if there is no complete line in the buffer yet
+  bool takeLine(std::string& line) {
+    const size_t& eol = buffer.find('\n');
+    if (eol == std::string::npos) {
+      return false;
+    }
+    line.assign(buffer, 0, eol);
+    buffer.erase(0, eol + 1);
+    return true;
+  }
+
+  // one recv into the buffer, false on closed connection
+  bool receive() {
+    char data[1 << 16];
+    const ssize_t& received = recv(fd, data, sizeof(data), 0);
+    if (received <= 0) {
+      return false;
+    }
+    buffer.append(data, received);
+    return true;
+  }
+
+  // false on timeout or closed connection
+  bool readline(std::string& line, const int& timeout_ms) {
+    while (!takeLine(line)) {
+      pollfd p = {fd, POLLIN, 0};
+      const int& ready = poll(&p, 1, timeout_ms > 0 ? timeout_ms : -1);
+      if (ready <= 0) {
+        timed_out = ready == 0;
+        return false;
+      }
+      if (!receive()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // takes buffered lines of the reply, true when its <end> is reached
+  bool takeReply() {
+    std::string line;
+    while (takeLine(line)) {
+      if (line == "<end>") {
+        return true;
+      }
+      if (reply.empty()) {
+        reply = line;
+      }
+    }
+    return false;
+  }
+
+  bool send(const char* data, size_t size) {
+    while (size > 0) {
+      const ssize_t& sent = ::send(fd, data, size, MSG_NOSIGNAL);
+      if (sent <= 0) {
+        return false;
+      }
+      data += sent;
+      size -= sent;
+    }
+    return true;
+  }
+
+  void crash(const char* reason, const int& player_id) {
+    if (!crashed) {
+      fprintf(stderr, "player %d crashed: %s\n", player_id, reason);
+    }
+    crashed = true;
+  }
+};
+
+static int listenOn(const int& port) {
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  const int one = 1;
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  if (bind(fd, (sockaddr*) &address, sizeof(address)) < 0 || listen(fd, 1) < 0) {
+    fprintf(stderr, "cannot listen on port %d\n", port);
+    exit(1);
+  }
+  return fd;
+}
+
+static pid_t spawn(const std::string& command, const int& port, const int& core) {
+  const pid_t pid = fork();
+  if (pid == 0) {
+    if (core >= 0) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      CPU_SET(core, &set);
+      sched_setaffinity(0, sizeof(set), &set);
+    }
+    dup2(STDERR_FILENO, STDOUT_FILENO); // stdout of the server is only for the summary
+    const std::string& line = command + " 127.0.0.1 " + std::to_string(port) + " 0000000000000000";
+    execl("/bin/sh", "sh", "-c", line.c_str(), (char*) nullptr);
+    _exit(127);
+  }
+  return pid;
+}
+
+static bool acceptBot(Connection& connection, const int& timeout_ms) {
+  pollfd p = {connection.listen_fd, POLLIN, 0};
+  if (poll(&p, 1, timeout_ms) <= 0) {
+    return false;
+  }
+  connection.fd = ::accept(connection.listen_fd, nullptr, nullptr);
+  if (connection.fd < 0) {
+    return false;
+  }
+  const int one = 1;
+  setsockopt(connection.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  std::string line;
+  // protocol name and token
+  return connection.readline(line, timeout_ms) && line == "json" && connection.readline(line, timeout_ms);
+}
+
+// actions of player from the reply, in player coordinates, only own robots are applied
+static void applyActions(std::string message, LocalWorld& world, const int& player_id) {
+  const size_t& separator = message.find('|');
+  if (separator != std::string::npos) {
+    message.resize(separator);
+  }
+  rapidjson::Document document;
+  document.Parse(message.c_str());
+  if (document.HasParseError() || !document.IsObject()) {
+    return; // bad actions are skipped like on the official server
+  }
+  const double& sign = player_id == 1 ? 1 : -1;
+  for (auto it = document.MemberBegin(); it != document.MemberEnd(); ++it) {
+    const int& robot_id = atoi(it->name.GetString());
+    const auto& json = it->value;
+    if (!json.IsObject()) {
+      continue;
+    }
+    bool own = false;
+    for (const auto& robot : world.robots) {
+      own |= robot.id == robot_id && robot.player_id == player_id;
+    }
+    if (!own) {
+      continue;
+    }
+    model::Action action;
+    auto number = [&json](const char* key) {
+      return json.HasMember(key) && json[key].IsNumber() ? json[key].GetDouble() : 0.;
+    };
+    action.target_velocity_x = number("target_velocity_x") * sign;
+    action.target_velocity_y = number("target_velocity_y");
+    action.target_velocity_z = number("target_velocity_z") * sign;
+    action.jump_speed = std::clamp(number("jump_speed"), 0., world.rules.ROBOT_MAX_JUMP_SPEED);
+    action.use_nitro = json.HasMember("use_nitro") && json["use_nitro"].IsBool() && json["use_nitro"].GetBool();
+    world.setAction(robot_id, action);
+  }
+}
+
+static void usage(const char* name) {
+  fprintf(stderr,
+          "usage: %s [--p1 cmd] [--p2 cmd] [--p1-port 31001] [--p2-port 31002] [--p1-core -1] [--p2-core -1]\n"
+          "          [--team-size 3] [--ticks 18000] [--seed 229] [--no-nitro] [--tick-timeout-ms 0] [--quiet]\n"
+          "bot command gets host, port and token as arguments, without command server waits for a connection\n",
+          name);
+  exit(1);
+}
+
+int main(int argc, char* argv[]) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string& arg = argv[i];
+    auto value = [&]() {
+      if (i + 1 >= argc) {
+        usage(argv[0]);
+      }
+      return std::string(argv[++i]);
+    };
+    if (arg == "--p1") {
+      options.command[0] = value();
+    } else if (arg == "--p2") {
+      options.command[1] = value();
+    } else if (arg == "--p1-port") {
+      options.port[0] = std::stoi(value());
+    } else if (arg == "--p2-port") {
+      options.port[1] = std::stoi(value());
+    } else if (arg == "--p1-core") {
+      options.core[0] = std::stoi(value());
+    } else if (arg == "--p2-core") {
+      options.core[1] = std::stoi(value());
+    } else if (arg == "--team-size") {
+      options.team_size = std::stoi(value());
+    } else if (arg == "--ticks") {
+      options.ticks = std::stoi(value());
+    } else if (arg == "--seed") {
+      options.seed = std::stoll(value());
+    } else if (arg == "--no-nitro") {
+      options.nitro = false;
+    } else if (arg == "--tick-timeout-ms") {
+      options.tick_timeout_ms = std::stoi(value());
+    } else if (arg == "--quiet") {
+      options.quiet = true;
+    } else {
+      usage(argv[0]);
+    }
+  }
+  signal(SIGPIPE, SIG_IGN);
+
+  const model::Rules& rules = LocalWorld::defaultRules(options.team_size, options.ticks, options.seed, options.nitro);
+  LocalWorld world(rules, options.nitro);
+
+  Connection connections[2];
+  for (int i = 0; i < 2; ++i) {
+    connections[i].listen_fd = listenOn(options.port[i]);
+  }
+  for (int i = 0; i < 2; ++i) {
+    if (!options.command[i].empty()) {
+      connections[i].pid = spawn(options.command[i], options.port[i], options.core[i]);
+    }
+  }
+
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  LocalWorld::writeRules(writer, rules);
+  buffer.Put('\n');
+  for (int i = 0; i < 2; ++i) {
+    auto& connection = connections[i];
+    if (!acceptBot(connection, options.connect_timeout_ms)) {
+      connection.crash("no connection", i + 1);
+    } else if (!connection.send(buffer.GetString(), buffer.GetSize())) {
+      connection.crash("cannot send rules", i + 1);
+    }
+    close(connection.listen_fd);
+  }
+
+  const Clock::time_point& game_start = Clock::now();
+  while (!world.finished()) {
+    const bool crashed[2] = {connections[0].crashed, connections[1].crashed};
+    Clock::time_point sent[2];
+    for (int i = 0; i < 2; ++i) {
+      auto& connection = connections[i];
+      if (connection.crashed) {
+        continue;
+      }
+      buffer.Clear();
+      writer.Reset(buffer);
+      world.writeGame(writer, i + 1, crashed);
+      buffer.Put('\n');
+      sent[i] = Clock::now();
+      if (!connection.send(buffer.GetString(), buffer.GetSize())) {
+        connection.crash("cannot send game", i + 1);
+      }
+    }
+    // both bots think at the same time, replies are polled together and every <end> is timed against
+    // the game message of its own player, so one bot's thinking is not added to the other's latency
+    auto fail = [&](const int& i) {
+      connections[i].crash("no actions", i + 1);
+      for (const auto& robot : world.robots) {
+        if (robot.player_id == i + 1) {
+          world.setAction(robot.id, model::Action());
+        }
+      }
+    };
+    bool waiting[2];
+    for (int i = 0; i < 2; ++i) {
+      waiting[i] = !connections[i].crashed;
+      connections[i].reply.clear();
+    }
+    while (waiting[0] || waiting[1]) {
+      pollfd fds[2];
+      int players[2];
+      int count = 0;
+      int timeout_ms = -1;
+      const Clock::time_point& now = Clock::now();
+      for (int i = 0; i < 2; ++i) {
+        if (!waiting[i]) {
+          continue;
+        }
+        if (options.tick_timeout_ms > 0) {
+          const double& left_ms = options.tick_timeout_ms
+              - std::chrono::duration<double, std::milli>(now - sent[i]).count();
+          if (left_ms <= 0) {
+            connections[i].timed_out = true;
+            connections[i].timeouts++;
+            fail(i);
+            waiting[i] = false;
+            continue;
+          }
+          const int& left = (int) std::ceil(left_ms);
+          timeout_ms = timeout_ms < 0 ? left : std::min(timeout_ms, left);
+        }
+        fds[count] = {connections[i].fd, POLLIN, 0};
+        players[count++] = i;
+      }
+      if (count == 0 || poll(fds, count, timeout_ms) <= 0) {
+        continue; // deadlines are checked above
+      }
+      const Clock::time_point& received = Clock::now();
+      for (int k = 0; k < count; ++k) {
+        const int& i = players[k];
+        auto& connection = connections[i];
+        if (fds[k].revents == 0) {
+          continue;
+        }
+        if (!connection.receive()) {
+          fail(i);
+          waiting[i] = false;
+        } else if (connection.takeReply()) {
+          const double& latency = std::chrono::duration<double>(received - sent[i]).count();
+          connection.latency_sum += latency;
+          connection.latency_max = std::max(connection.latency_max, latency);
+          connection.responses++;
+          waiting[i] = false;
+        }
+      }
+    }
+    for (int i = 0; i < 2; ++i) {
+      if (!connections[i].crashed) {
+        applyActions(connections[i].reply, world, i + 1);
+      }
+    }
+    world.tick();
+    if (!options.quiet && world.current_tick % 1000 == 0) {
+      fprintf(stderr, "tick %d score %d:%d\n", world.current_tick, world.score[0], world.score[1]);
+    }
+  }
+  const double& game_time = std::chrono::duration<double>(Clock::now() - game_start).count();
+
+  for (int i = 0; i < 2; ++i) {
+    auto& connection = connections[i];
+    if (connection.fd >= 0) {
+      close(connection.fd);
+    }
+    if (connection.pid > 0) {
+      int status;
+      rusage usage;
+      if (wait4(connection.pid, &status, 0, &usage) == connection.pid) {
+        connection.cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6
+            + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec * 1e-6;
+      }
+    }
+  }
+
+  auto latency_avg = [&](const int& i) {
+    return connections[i].responses == 0 ? 0. : 1000 * connections[i].latency_sum / connections[i].responses;
+  };
+  printf("{\"seed\":%lld,\"ticks\":%d,\"score\":[%d,%d],\"crashed\":[%s,%s],\"timeouts\":[%d,%d],"
+         "\"latency_avg_ms\":[%.3f,%.3f],\"latency_max_ms\":[%.3f,%.3f],\"cpu_seconds\":[%.3f,%.3f],\"game_seconds\":%.3f}\n",
+         options.seed, world.current_tick, world.score[0], world.score[1],
+         connections[0].crashed ? "true" : "false", connections[1].crashed ? "true" : "false",
+         connections[0].timeouts, connections[1].timeouts,
+         latency_avg(0), latency_avg(1),
+         1000 * connections[0].latency_max, 1000 * connections[1].latency_max,
+         connections[0].cpu_time, connections[1].cpu_time, game_time);
+  return 0;
+}
@@ -0,0 +1,438 @@
+#ifndef CODEBALL_LOCALWORLD_H
+#define CODEBALL_LOCALWORLD_H
+
+#ifdef LOCAL
+#include <model/Dan.h>
+#include <model/Game.h>
+#include <model/Action.h>
+#else
+#include "model/Dan.h"
+#include "model/Game.h"
+#include "model/Action.h"
+#endif
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// reference game physics for the local server, straight from the rules pseudo-code
+// only arena distance goes through ArenaGeometry, it matches full arena within 1e-9
+// player 1 defends z < 0, game for player 2 is rotated by 180 degrees around y
+struct LocalWorld {
+
+  struct Body {
+    Point position;
+    Point velocity;
+    double radius;
+    double radius_change_speed;
+    double mass;
+    double arena_e;
+  };
+
+  struct Robot : Body {
+    int id;
+    int player_id;
+    double nitro;
+    bool touch;
+    Point touch_normal;
+    model::Action action;
+  };
+
+  struct Pack {
+    int id;
+    Point position;
+    double radius;
+    bool alive;
+    int respawn_ticks;
+  };
+
+  model::Rules rules;
+  std::mt19937_64 rd;
+  bool nitro;
+
+  int current_tick = 0;
+  int score[2] = {0, 0};
+  int reset_ticks = 0; // ticks left till positions reset after goal, 0 - ball in play
+
+  std::vector<Robot> robots;
+  std::vector<Robot*> order; // shuffled every microtick
+  Body ball;
+  std::vector<Pack> packs;
+
+  // official values, nitro packs only in nitro mode
+  static model::Rules defaultRules(const int team_size, const int max_tick_count, const long long seed, const bool nitro) {
+    model::Rules rules;
+    rules.max_tick_count = max_tick_count;
+    rules.arena = {60, 20, 80, 3, 7, 13, 3, 20, 10, 10, 1};
+    rules.team_size = team_size;
+    rules.seed = seed;
+    rules.ROBOT_MIN_RADIUS = 1;
+    rules.ROBOT_MAX_RADIUS = 1.05;
+    rules.ROBOT_MAX_JUMP_SPEED = 15;
+    rules.ROBOT_ACCELERATION = 100;
+    rules.ROBOT_NITRO_ACCELERATION = 30;
+    rules.ROBOT_MAX_GROUND_SPEED = 30;
+    rules.ROBOT_ARENA_E = 0;
+    rules.ROBOT_RADIUS = 1;
+    rules.ROBOT_MASS = 2;
+    rules.TICKS_PER_SECOND = 60;
+    rules.MICROTICKS_PER_TICK = 100;
+    rules.RESET_TICKS = 2 * 60;
+    rules.BALL_ARENA_E = 0.7;
+    rules.BALL_RADIUS = 2;
+    rules.BALL_MASS = 1;
+    rules.MIN_HIT_E = 0.4;
+    rules.MAX_HIT_E = 0.5;
+    rules.MAX_ENTITY_SPEED = 100;
+    rules.MAX_NITRO_AMOUNT = 100;
+    rules.START_NITRO_AMOUNT = nitro ? 50 : 0;
+    rules.NITRO_POINT_VELOCITY_CHANGE = 0.6;
+    rules.NITRO_PACK_X = 20;
+    rules.NITRO_PACK_Y = 1;
+    rules.NITRO_PACK_Z = 30;
+    rules.NITRO_PACK_RADIUS = 0.5;
+    rules.NITRO_PACK_AMOUNT = 100;
+    rules.NITRO_PACK_RESPAWN_TICKS = 10 * 60;
+    rules.GRAVITY = 30;
+    return rules;
+  }
+
+  LocalWorld(const model::Rules& rules, const bool nitro) : rules(rules), rd(rules.seed), nitro(nitro) {
+    ArenaGeometry::build(rules.arena, {rules.ROBOT_MAX_RADIUS, rules.BALL_RADIUS});
+    for (int player = 0; player < 2; ++player) {
+      for (int i = 0; i < rules.team_size; ++i) {
+        Robot robot;
+        robot.id = player * rules.team_size + i + 1;
+        robot.player_id = player + 1;
+        robot.mass = rules.ROBOT_MASS;
+        robot.arena_e = rules.ROBOT_ARENA_E;
+        robots.push_back(robot);
+      }
+    }
+    for (auto& robot : robots) {
+      order.push_back(&robot);
+    }
+    ball.mass = rules.BALL_MASS;
+    ball.arena_e = rules.BALL_ARENA_E;
+    if (nitro) {
+      int id = 2 * rules.team_size + 2;
+      for (const double& x : {-rules.NITRO_PACK_X, rules.NITRO_PACK_X}) {
+        for (const double& z : {-rules.NITRO_PACK_Z, rules.NITRO_PACK_Z}) {
+          packs.push_back({id++, {x, rules.NITRO_PACK_Y, z}, rules.NITRO_PACK_RADIUS, true, 0});
+        }
+      }
+    }
+    resetPositions();
+  }
+
+  double random(const double& a, const double& b) {
+    return std::uniform_real_distribution<double>(a, b)(rd);
+  }
+
+  // kickoff, robots of player 2 mirror robots of player 1
+  void resetPositions() {
+    const int& team_size = rules.team_size;
+    for (int i = 0; i < team_size; ++i) {
+      const double& x = (i - (team_size - 1) / 2.) * rules.arena.width / (team_size + 1) + random(-2, 2);
+      const double& z = -rules.arena.depth / 4 - random(0, rules.arena.depth / 8);
+      for (int player = 0; player < 2; ++player) {
+        auto& robot = robots[player * team_size + i];
+        const double& sign = player == 0 ? 1 : -1;
+        robot.position = {x * sign, rules.ROBOT_RADIUS, z * sign};
+        robot.velocity = {0, 0, 0};
+        robot.radius = rules.ROBOT_RADIUS;
+        robot.radius_change_speed = 0;
+        robot.nitro = rules.START_NITRO_AMOUNT;
+        robot.touch = true;
+        robot.touch_normal = {0, 1, 0};
+        robot.action = model::Action();
+      }
+    }
+    ball.position = {0, random(rules.BALL_RADIUS, 4 * rules.BALL_RADIUS), 0};
+    ball.velocity = {0, 0, 0};
+    ball.radius = rules.BALL_RADIUS;
+    ball.radius_change_speed = 0;
+    for (auto& pack : packs) {
+      pack.alive = true;
+      pack.respawn_ticks = 0;
+    }
+  }
+
+  bool finished() const {
+    return current_tick >= rules.max_tick_count;
+  }
+
+  // action in world coordinates
+  void setAction(const int& robot_id, const model::Action& action) {
+    for (auto& robot : robots) {
+      if (robot.id == robot_id) {
+        robot.action = action;
+      }
+    }
+  }
+
+  void tick() {
+    const double& delta_time = 1. / rules.TICKS_PER_SECOND;
+    for (int i = 0; i < rules.MICROTICKS_PER_TICK; ++i) {
+      update(delta_time / rules.MICROTICKS_PER_TICK);
+    }
+    for (auto& pack : packs) {
+      if (!pack.alive && --pack.respawn_ticks == 0) {
+        pack.alive = true;
+      }
+    }
+    current_tick++;
+    if (reset_ticks > 0 && --reset_ticks == 0) {
+      resetPositions();
+    }
+  }
+
+  void update(const double& delta_time) {
+    std::shuffle(order.begin(), order.end(), rd);
+    for (auto& robot : order) {
+      if (robot->touch) {
+        Point target_velocity = Point{robot->action.target_velocity_x, robot->action.target_velocity_y, robot->action.target_velocity_z}
+            .clamp(rules.ROBOT_MAX_GROUND_SPEED);
+        target_velocity -= robot->touch_normal * robot->touch_normal.dot(target_velocity);
+        const Point& target_velocity_change = target_velocity - robot->velocity;
+        if (target_velocity_change.length_sq() > 0) {
+          const double& acceleration = rules.ROBOT_ACCELERATION * std::max(0., robot->touch_normal.y);
+          robot->velocity += (target_velocity_change.normalize() * (acceleration * delta_time))
+              .clamp(target_velocity_change.length());
+        }
+      }
+      if (robot->action.use_nitro) {
+        const Point& target_velocity_change = (Point{robot->action.target_velocity_x, robot->action.target_velocity_y, robot->action.target_velocity_z}
+            - robot->velocity).clamp(robot->nitro * rules.NITRO_POINT_VELOCITY_CHANGE);
+        if (target_velocity_change.length_sq() > 0) {
+          const Point& acceleration = target_velocity_change.normalize() * rules.ROBOT_NITRO_ACCELERATION;
+          const Point& velocity_change = (acceleration * delta_time).clamp(target_velocity_change.length());
+          robot->velocity += velocity_change;
+          robot->nitro -= velocity_change.length() / rules.NITRO_POINT_VELOCITY_CHANGE;
+        }
+      }
+      move(*robot, delta_time);
+      robot->radius = rules.ROBOT_MIN_RADIUS
+          + (rules.ROBOT_MAX_RADIUS - rules.ROBOT_MIN_RADIUS) * robot->action.jump_speed / rules.ROBOT_MAX_JUMP_SPEED;
+      robot->radius_change_speed = robot->action.jump_speed;
+    }
+    move(ball, delta_time);
+
+    for (int i = 0; i < (int) order.size(); ++i) {
+      for (int j = 0; j < i; ++j) {
+        collideEntities(*order[i], *order[j]);
+      }
+    }
+    Point collision_normal;
+    for (auto& robot : order) {
+      collideEntities(*robot, ball);
+      if (!collideWithArena(*robot, collision_normal)) {
+        robot->touch = false;
+      } else {
+        robot->touch = true;
+        robot->touch_normal = collision_normal;
+      }
+    }
+    collideWithArena(ball, collision_normal);
+
+    if (reset_ticks == 0 && fabs(ball.position.z) > rules.arena.depth / 2 + ball.radius) {
+      score[ball.position.z > 0 ? 0 : 1]++;
+      reset_ticks = rules.RESET_TICKS;
+    }
+
+    for (auto& robot : order) {
+      if (robot->nitro == rules.MAX_NITRO_AMOUNT) {
+        continue;
+      }
+      for (auto& pack : packs) {
+        if (pack.alive && (robot->position - pack.position).length() <= robot->radius + pack.radius) {
+          robot->nitro = rules.MAX_NITRO_AMOUNT;
+          pack.alive = false;
+          pack.respawn_ticks = rules.NITRO_PACK_RESPAWN_TICKS;
+        }
+      }
+    }
+  }
+
+  void move(Body& e, const double& delta_time) {
+    e.velocity = e.velocity.clamp(rules.MAX_ENTITY_SPEED);
+    e.position += e.velocity * delta_time;
+    e.position.y -= rules.GRAVITY * delta_time * delta_time / 2;
+    e.velocity.y -= rules.GRAVITY * delta_time;
+  }
+
+  void collideEntities(Body& a, Body& b) {
+    const Point& delta_position = b.position - a.position;
+    const double& distance = delta_position.length();
+    const double& penetration = a.radius + b.radius - distance;
+    if (penetration > 0) {
+      const double& k_a = (1 / a.mass) / ((1 / a.mass) + (1 / b.mass));
+      const double& k_b = (1 / b.mass) / ((1 / a.mass) + (1 / b.mass));
+      const Point& normal = delta_position.normalize();
+      a.position -= normal * (penetration * k_a);
+      b.position += normal * (penetration * k_b);
+      const double& delta_velocity = (b.velocity - a.velocity).dot(normal) - b.radius_change_speed - a.radius_change_speed;
+      if (delta_velocity < 0) {
+        const Point& impulse = normal * ((1 + random(rules.MIN_HIT_E, rules.MAX_HIT_E)) * delta_velocity);
+        a.velocity += impulse * k_a;
+        b.velocity -= impulse * k_b;
+      }
+    }
+  }
+
+  bool collideWithArena(Body& e, Point& collision_normal) {
+    const Dan& dan = Dan::dan_to_arena(e.position, e.radius);
+    const double& penetration = e.radius - dan.distance;
+    if (penetration > 0) {
+      const Point& normal = dan.normal.normalize();
+      e.position += normal * penetration;
+      const double& velocity = e.velocity.dot(normal) - e.radius_change_speed;
+      if (velocity < 0) {
+        e.velocity -= normal * ((1 + e.arena_e) * velocity);
+      }
+      collision_normal = normal;
+      return true;
+    }
+    return false;
+  }
+
+  // game as seen by player, player_id 1 or 2
+  template<typename Writer>
+  void writeGame(Writer& writer, const int& player_id, const bool crashed[2]) const {
+    const double& sign = player_id == 1 ? 1 : -1;
+    writer.StartObject();
+    writer.Key("current_tick");
+    writer.Int(current_tick);
+    writer.Key("players");
+    writer.StartArray();
+    for (int id = 1; id <= 2; ++id) {
+      writer.StartObject();
+      writer.Key("id");
+      writer.Int(id);
+      writer.Key("me");
+      writer.Bool(id == player_id);
+      writer.Key("strategy_crashed");
+      writer.Bool(crashed[id - 1]);
+      writer.Key("score");
+      writer.Int(score[id - 1]);
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.Key("robots");
+    writer.StartArray();
+    for (const auto& robot : robots) {
+      writer.StartObject();
+      writer.Key("id");
+      writer.Int(robot.id);
+      writer.Key("player_id");
+      writer.Int(robot.player_id);
+      writer.Key("is_teammate");
+      writer.Bool(robot.player_id == player_id);
+      writePoint(writer, "", robot.position, sign);
+      writePoint(writer, "velocity_", robot.velocity, sign);
+      writer.Key("radius");
+      writer.Double(robot.radius);
+      writer.Key("nitro_amount");
+      writer.Double(robot.nitro);
+      writer.Key("touch");
+      writer.Bool(robot.touch);
+      if (robot.touch) {
+        writePoint(writer, "touch_normal_", robot.touch_normal, sign);
+      } else {
+        for (const char* key : {"touch_normal_x", "touch_normal_y", "touch_normal_z"}) {
+          writer.Key(key);
+          writer.Null();
+        }
+      }
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.Key("nitro_packs");
+    writer.StartArray();
+    for (const auto& pack : packs) {
+      writer.StartObject();
+      writer.Key("id");
+      writer.Int(pack.id);
+      writePoint(writer, "", pack.position, sign);
+      writer.Key("radius");
+      writer.Double(pack.radius);
+      writer.Key("respawn_ticks");
+      if (pack.alive) {
+        writer.Null();
+      } else {
+        writer.Int(pack.respawn_ticks);
+      }
+      writer.EndObject();
+    }
+    writer.EndArray();
+    writer.Key("ball");
+    writer.StartObject();
+    writePoint(writer, "", ball.position, sign);
+    writePoint(writer, "velocity_", ball.velocity, sign);
+    writer.Key("radius");
+    writer.Double(ball.radius);
+    writer.EndObject();
+    writer.EndObject();
+  }
+
+  template<typename Writer>
+  static void writePoint(Writer& writer, const std::string& prefix, const Point& point, const double& sign) {
+    writer.Key((prefix + "x").c_str());
+    writer.Double(point.x * sign);
+    writer.Key((prefix + "y").c_str());
+    writer.Double(point.y);
+    writer.Key((prefix + "z").c_str());
+    writer.Double(point.z * sign);
+  }
+
+  template<typename Writer>
+  static void writeRules(Writer& writer, const model::Rules& rules) {
+    writer.StartObject();
+    writer.Key("max_tick_count");
+    writer.Int(rules.max_tick_count);
+    writer.Key("arena");
+    writer.StartObject();
+    const auto& arena = rules.arena;
+    const std::pair<const char*, double> arena_fields[] = {
+        {"width", arena.width}, {"height", arena.height}, {"depth", arena.depth},
+        {"bottom_radius", arena.bottom_radius}, {"top_radius", arena.top_radius},
+        {"corner_radius", arena.corner_radius}, {"goal_top_radius", arena.goal_top_radius},
+        {"goal_width", arena.goal_width}, {"goal_height", arena.goal_height},
+        {"goal_depth", arena.goal_depth}, {"goal_side_radius", arena.goal_side_radius}};
+    for (const auto& field : arena_fields) {
+      writer.Key(field.first);
+      writer.Double(field.second);
+    }
+    writer.EndObject();
+    writer.Key("team_size");
+    writer.Int(rules.team_size);
+    writer.Key("seed");
+    writer.Int64(rules.seed);
+    const std::pair<const char*, double> double_fields[] = {
+        {"ROBOT_MIN_RADIUS", rules.ROBOT_MIN_RADIUS}, {"ROBOT_MAX_RADIUS", rules.ROBOT_MAX_RADIUS},
+        {"ROBOT_MAX_JUMP_SPEED", rules.ROBOT_MAX_JUMP_SPEED}, {"ROBOT_ACCELERATION", rules.ROBOT_ACCELERATION},
+        {"ROBOT_NITRO_ACCELERATION", rules.ROBOT_NITRO_ACCELERATION}, {"ROBOT_MAX_GROUND_SPEED", rules.ROBOT_MAX_GROUND_SPEED},
+        {"ROBOT_ARENA_E", rules.ROBOT_ARENA_E}, {"ROBOT_RADIUS", rules.ROBOT_RADIUS}, {"ROBOT_MASS", rules.ROBOT_MASS},
+        {"BALL_ARENA_E", rules.BALL_ARENA_E}, {"BALL_RADIUS", rules.BALL_RADIUS}, {"BALL_MASS", rules.BALL_MASS},
+        {"MIN_HIT_E", rules.MIN_HIT_E}, {"MAX_HIT_E", rules.MAX_HIT_E}, {"MAX_ENTITY_SPEED", rules.MAX_ENTITY_SPEED},
+        {"MAX_NITRO_AMOUNT", rules.MAX_NITRO_AMOUNT}, {"START_NITRO_AMOUNT", rules.START_NITRO_AMOUNT},
+        {"NITRO_POINT_VELOCITY_CHANGE", rules.NITRO_POINT_VELOCITY_CHANGE},
+        {"NITRO_PACK_X", rules.NITRO_PACK_X}, {"NITRO_PACK_Y", rules.NITRO_PACK_Y}, {"NITRO_PACK_Z", rules.NITRO_PACK_Z},
+        {"NITRO_PACK_RADIUS", rules.NITRO_PACK_RADIUS}, {"NITRO_PACK_AMOUNT", rules.NITRO_PACK_AMOUNT},
+        {"GRAVITY", rules.GRAVITY}};
+    for (const auto& field : double_fields) {
+      writer.Key(field.first);
+      writer.Double(field.second);
+    }
+    const std::pair<const char*, int> int_fields[] = {
+        {"TICKS_PER_SECOND", rules.TICKS_PER_SECOND}, {"MICROTICKS_PER_TICK", rules.MICROTICKS_PER_TICK},
+        {"RESET_TICKS", rules.RESET_TICKS}, {"NITRO_PACK_RESPAWN_TICKS", rules.NITRO_PACK_RESPAWN_TICKS}};
+    for (const auto& field : int_fields) {
+      writer.Key(field.first);
+      writer.Int(field.second);
+    }
+    writer.EndObject();
+  }
+};
+
+#endif //CODEBALL_LOCALWORLD_H
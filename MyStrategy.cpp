@@ -4,19 +4,29 @@
 #include <model/P.h>
 #include <H.h>
 #include <SmartSimulator.h>
+#include <model/Profiler.h>
+#include <Telemetry.h>
+#include <OpponentModel.h>
+#include <FidelityMonitor.h>
 #else
 #include "MyStrategy.h"
 #include "SmartSimulator.h"
 #include "model/C.h"
 #include "model/P.h"
 #include "H.h"
+#include "model/Profiler.h"
+#include "Telemetry.h"
+#include "OpponentModel.h"
+#include "FidelityMonitor.h"
 #endif
 
+#include <memory>
+
 void clearBestPlans() {
-  for (int id = 0; id < 3; id++) {
+  for (int id = 0; id < H::team_size; id++) {
     H::best_plan[id].clearAndShift(C::MAX_SIMULATION_DEPTH);
   }
-  for (int id = 3; id < 6; id++) {
+  for (int id = H::team_size; id < 2 * H::team_size; id++) {
     H::best_plan[id].clearAndShift(C::ENEMY_SIMULATION_DEPTH);
   }
 }
@@ -37,9 +47,12 @@ void addCell(int x, int y, int z, int t, int tpt) {
   }
 }
 
+int predictEnemies();
+
 int enemiesPrediction() {
+  PROFILE_ZONE(ENEMIES_PREDICTION);
 
-  for (int id = 0; id < 6; ++id) {
+  for (int id = 0; id < 2 * H::team_size; ++id) {
     for (auto& robot : H::game.robots) {
       if (robot.id == H::getRobotGlobalIdByLocal(id)) {
         static constexpr double jr = 0.0033333333333333333333333333333;
@@ -58,8 +71,7 @@ int enemiesPrediction() {
     }
   }
 
-  //H::t[2].start();
-  for (int id = 0; id < 6; ++id) {
+  for (int id = 0; id < 2 * H::team_size; ++id) {
     for (auto& robot : H::game.robots) {
       if (robot.id == H::getRobotGlobalIdByLocal(id)) {
         Point v0 = H::prev_velocity[id];
@@ -84,6 +96,9 @@ int enemiesPrediction() {
           if (fabs(dvx) < eps && fabs(dvz) < eps && fabs(dvy - (-1./2)) < eps) {
             using_nitro = false;
           }
+#ifdef OPPONENT_MODEL
+          OpponentModel::observeFlight(id, robot, using_nitro);
+#endif
           if (using_nitro) {
             //P::logn(dvy);
             double min_error = 1e9;
@@ -174,12 +189,24 @@ int enemiesPrediction() {
           //}
 
           H::prev_last_action[H::getRobotLocalIdByGlobal(robot.id)] = {ax, az};
+#ifdef OPPONENT_MODEL
+          if (!robot.is_teammate) {
+            OpponentModel::observeGround(id, robot, cur);
+            if (!is_dribler) {
+              OpponentModel::predict(id, robot, H::last_action_plan[id], H::last_action0_plan[id]);
+            }
+          }
+#endif
 
         }
       }
     }
   }
-  //H::t[2].cur(true);
+  return predictEnemies();
+}
+
+// fills danger grid with enemy positions, returns min time when enemy can hit the ball
+int predictEnemies() {
   for (int i = 0; i < H::used_cells_size; ++i) {
     const auto& cell = H::used_cells[i];
     H::danger_grid[cell.x][cell.y][cell.z][cell.t] = 0;
@@ -191,8 +218,7 @@ int enemiesPrediction() {
 
   int min_time_for_enemy_to_hit_the_ball = C::NEVER;
 
-  //H::t[1].start();
-  for (int enemy_id : {3, 4, 5}) {
+  for (int enemy_id = H::team_size; enemy_id < 2 * H::team_size; ++enemy_id) {
     SmartSimulator simulator(true, C::TPT, C::ENEMY_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(enemy_id), 3, H::game.robots, H::game.ball, {});
     for (int iteration = 0; iteration < 100; iteration++) {
       Plan cur_plan(61, C::ENEMY_SIMULATION_DEPTH);
@@ -260,8 +286,6 @@ int enemiesPrediction() {
       }
     }*/
   }
-  //H::t[1].cur(true, true);
-  //P::logn(H::t[1].avg());
   //P::logn("mtfethtb: ", min_time_for_enemy_to_hit_the_ball);
   return min_time_for_enemy_to_hit_the_ball;
 }
@@ -310,13 +334,855 @@ void updateRoles() {
   }
   H::role[H::getRobotLocalIdByGlobal(closest_to_goal)] = H::DEFENDER;
   //P::logn("def: ", closest_to_goal);
+  if (H::team_size == 2) { // no semi in 2x2
+    H::role[H::getRobotLocalIdByGlobal(closest_to_goal2)] = H::FIGHTER;
+    return;
+  }
   H::role[H::getRobotLocalIdByGlobal(closest_to_goal2)] = H::SEMI;
   //P::logn("fi: ", closest_to_goal2);
   H::role[H::getRobotLocalIdByGlobal(other)] = H::FIGHTER;
   //P::logn("semi: ", other);
 }
 
+// scoring state of evaluatePlan between ticks, tree search copies it together with simulator snapshot
+struct Evaluation {
+  double multiplier;
+  double goal_multiplier;
+  bool collide_with_smth;
+  bool fly_on_prefix;
+  bool stopped; // plan is rejected, score is minimal
+};
+
+void startEvaluation(SmartSimulator& simulator, Evaluation& evaluation) {
+  evaluation.multiplier = 1.;
+  evaluation.goal_multiplier = 1.;
+  evaluation.collide_with_smth = false;
+  evaluation.fly_on_prefix = (!simulator.main_robot->state.touch || simulator.main_robot->state.touch_surface_id != 1);
+  evaluation.stopped = false;
+}
+
+// simulates and scores ticks [from, to) of the plan
+void evaluateTicks(
+    SmartSimulator& simulator,
+    Plan& cur_plan,
+    Evaluation& evaluation,
+    const int from,
+    const int to,
+    const int id,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball) {
+  PROFILE_ZONE(SCORING);
+  double& multiplier = evaluation.multiplier;
+  double& goal_multiplier = evaluation.goal_multiplier;
+  bool& collide_with_smth = evaluation.collide_with_smth;
+  bool& fly_on_prefix = evaluation.fly_on_prefix;
+
+  for (int sim_tick = from; sim_tick < to && !evaluation.stopped; sim_tick++) {
+
+    bool main_touch = (simulator.main_robot->state.touch && simulator.main_robot->state.touch_surface_id == 1) || simulator.main_robot->state.position.y < C::NITRO_TOUCH_EPSILON;
+
+    int main_robot_additional_jump_type = simulator.tickDynamic(sim_tick, H::getRobotGlobalIdByLocal(0), false);
+
+    fly_on_prefix &= (!simulator.main_robot->state.touch || simulator.main_robot->state.touch_surface_id != 1);
+
+    if (main_robot_additional_jump_type == 0 && simulator.main_robot->action.jump_speed > 0 && main_touch) {
+      cur_plan.was_jumping = true;
+    }
+
+    if (main_robot_additional_jump_type > 0) { // 1 - with ball, 2 - with entity, 3 - additional
+      if (fly_on_prefix &&
+          (main_robot_additional_jump_type == 1 || main_robot_additional_jump_type == 2)) {
+        collide_with_smth = true;
+      }
+      if ((main_robot_additional_jump_type == 1 || main_robot_additional_jump_type == 2)
+          && cur_plan.was_jumping
+          && !cur_plan.was_on_ground_after_jumping
+          && !cur_plan.collide_with_entity_before_on_ground_after_jumping) {
+        cur_plan.collide_with_entity_before_on_ground_after_jumping = true;
+        if (H::role[id] == H::DEFENDER && main_robot_additional_jump_type == 1
+            && min_time_for_enemy_to_hit_the_ball < sim_tick
+            && cur_plan.time_jump <= min_time_for_enemy_to_hit_the_ball) {
+          cur_plan.score.minimal();
+          evaluation.stopped = true;
+          break;
+        }
+        if (sim_tick - cur_plan.time_jump > C::LONGEST_JUMP) {
+          cur_plan.score.minimal();
+          evaluation.stopped = true;
+          break;
+        }
+      }
+      if (cur_plan.oncoming_jump == C::NEVER) {
+        cur_plan.oncoming_jump = sim_tick;
+        cur_plan.oncoming_jump_speed = main_robot_additional_jump_type == 3 ?
+            std::max(C::MIN_WALL_JUMP, cur_plan.max_jump_speed) : cur_plan.max_jump_speed;
+      }
+    }
+
+    if (cur_plan.was_jumping && !cur_plan.was_on_ground_after_jumping && simulator.main_robot->state.touch) {
+      cur_plan.was_on_ground_after_jumping = true;
+      if (!cur_plan.collide_with_entity_before_on_ground_after_jumping) {
+        cur_plan.score.minimal();
+        evaluation.stopped = true;
+        break;
+      }
+    }
+
+    if (H::role[id] == H::FIGHTER) {
+      cur_plan.score.sum_score += simulator.getSumScoreFighter(sim_tick, goal_multiplier, ball_on_my_side, true) * multiplier;
+      cur_plan.score.fighter_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_ball);
+      cur_plan.score.fighter_min_dist_to_goal = std::min(simulator.getMinDistToGoalScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_goal);
+      cur_plan.score.fighter_closest_enemy_ever = std::min(simulator.getMinDistToEnemyScore() * multiplier, cur_plan.score.fighter_closest_enemy_ever);
+      if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
+        cur_plan.score.fighter_last_dist_to_goal = simulator.getMinDistToGoalScoreFighter();
+      }
+      if (sim_tick == C::ENEMY_LIVE_TICKS - 1) {
+        cur_plan.score.fighter_closest_enemy_last = simulator.getMinDistToEnemyScore();
+      }
+    } else if (H::role[id] == H::DEFENDER) {
+      cur_plan.score.sum_score += simulator.getSumScoreDefender(sim_tick, ball_on_my_side) * multiplier;
+      cur_plan.score.defender_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreDefender() * multiplier, cur_plan.score.defender_min_dist_to_ball);
+      cur_plan.score.defender_min_dist_from_goal = std::min(simulator.getMinDistFromGoalScoreDefender() * multiplier, cur_plan.score.defender_min_dist_from_goal);
+      if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
+        cur_plan.score.defender_last_dist_from_goal = simulator.getMinDistFromGoalScoreDefender();
+      }
+    } else if (H::role[id] == H::SEMI) {
+      cur_plan.score.sum_score += simulator.getSumScoreFighter(sim_tick, goal_multiplier, ball_on_my_side, false) * multiplier;
+      cur_plan.score.fighter_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_ball);
+      cur_plan.score.fighter_min_dist_to_goal = std::min(simulator.getMinDistToGoalScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_goal);
+      cur_plan.score.fighter_closest_enemy_ever = std::min(simulator.getMinDistToEnemyScore() * multiplier, cur_plan.score.fighter_closest_enemy_ever);
+      if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
+        cur_plan.score.fighter_last_dist_to_goal = simulator.getMinDistToGoalScoreFighter();
+      }
+      if (sim_tick == C::ENEMY_LIVE_TICKS - 1) {
+        cur_plan.score.fighter_closest_enemy_last = simulator.getMinDistToEnemyScore();
+      }
+    }
+
+    multiplier *= 0.999;
+    const double g_mult = 0.85;
+    goal_multiplier *= g_mult * g_mult;
+  }
+}
+
+// jump and nitro timings of the plan after the last evaluated tick
+void finishEvaluation(Plan& cur_plan, const Evaluation& evaluation) {
+  if (!evaluation.collide_with_smth) {
+    cur_plan.time_nitro_on = C::NEVER;
+    cur_plan.time_nitro_off = C::NEVER;
+  }
+
+  if (!cur_plan.was_jumping) {
+    cur_plan.time_jump = C::NEVER;
+  } else if (cur_plan.was_jumping && !cur_plan.collide_with_entity_before_on_ground_after_jumping) {
+    cur_plan.score.minimal();
+  } else {
+    if (cur_plan.oncoming_jump == C::NEVER) {
+      cur_plan.oncoming_jump = cur_plan.time_jump;
+      cur_plan.oncoming_jump_speed = cur_plan.max_jump_speed;
+    } else if (cur_plan.time_jump != C::NEVER) {
+      if (cur_plan.oncoming_jump > cur_plan.time_jump) {
+        cur_plan.oncoming_jump = cur_plan.time_jump;
+        cur_plan.oncoming_jump_speed = cur_plan.max_jump_speed;
+      }
+    }
+  }
+}
+
+// one simulation of the plan for main robot of simulator, fills score, jump and nitro timings
+void evaluatePlan(SmartSimulator& simulator, Plan& cur_plan, const int id, const bool ball_on_my_side, const int min_time_for_enemy_to_hit_the_ball) {
+  Evaluation evaluation;
+  startEvaluation(simulator, evaluation);
+  evaluateTicks(simulator, cur_plan, evaluation, 0, C::MAX_SIMULATION_DEPTH, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+  finishEvaluation(cur_plan, evaluation);
+}
+
+// random plan for main robot of simulator (current best on iteration 0, seed if given), score is started by role
+Plan randomPlan(const SmartSimulator& simulator, const int id, const int iteration, const Plan* seed) {
+  int plan_type;
+  double rd = C::rand_double(0, 1);
+
+  if (simulator.main_robot->state.touch
+      && simulator.main_robot->state.touch_surface_id == 1) {
+    if (rd < 1. / 7) {
+      plan_type = 20;
+    } else if (rd < 2. / 7) {
+      plan_type = 21;
+    } else if (rd < 3. / 7) {
+      plan_type = 22;
+    } else if (rd < 4. / 7) {
+      plan_type = 23;
+    } else if (rd < 5. / 7) {
+      plan_type = 11;
+    } else if (rd < 6. / 7) {
+      plan_type = 12;
+    } else {
+      plan_type = 11;
+    }
+  } else {
+    if (rd < 0.8) {
+      plan_type = 31;
+    } else {
+      plan_type = 32;
+    }
+  }
+
+  Plan plan(plan_type, C::MAX_SIMULATION_DEPTH);
+  if (iteration == 0) {
+    plan = H::best_plan[id];
+  } else if (seed != nullptr) {
+    plan = *seed;
+    plan.clearEvaluation();
+  } else if (C::rand_double(0, 1) < 1. / 10.) { // todo check coefficient
+    plan = H::best_plan[id];
+    plan.mutate(plan.configuration, C::MAX_SIMULATION_DEPTH);
+  }
+
+  if (H::role[id] == H::FIGHTER) {
+    plan.score.start_fighter();
+  } else if (H::role[id] == H::SEMI) {
+    plan.score.start_fighter();
+  } else if (H::role[id] == H::DEFENDER) {
+    plan.score.start_defender();
+  }
+  return plan;
+}
+
+// full fidelity score of the plan: min over both enemy plans configurations
+Plan evaluateMinimax(
+    SmartSimulator& simulator_one,
+    SmartSimulator& simulator_two,
+    const bool need_minimax,
+    const int id,
+    const int iteration,
+    const Plan& plan,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball) {
+#ifdef EVAL_CACHE
+  // plans with equal quantized genome on the same simulators share the result, new simulators never hit old entries
+  const uint64_t& world = ((uint64_t) simulator_one.world_id << 32) | (uint32_t) simulator_two.world_id;
+  const uint64_t& key = Plan::mixKey(Plan::mixKey(plan.genomeKey(), ball_on_my_side), min_time_for_enemy_to_hit_the_ball);
+  PlanEvaluation& entry = H::evaluation_cache[Plan::mixKey(key, world) & (C::EVAL_CACHE_SIZE - 1)];
+  H::evaluation_lookups++;
+  if (entry.world == world && entry.key == key) {
+    H::evaluation_hits++;
+    Plan result = plan;
+    entry.applyTo(result);
+    return result;
+  }
+#endif
+  Plan cur_plan_one = plan;
+
+  simulator_one.initIteration(iteration, cur_plan_one);
+
+  Plan cur_plan_two = cur_plan_one;
+
+  simulator_two.initIteration(iteration, cur_plan_two);
+
+  cur_plan_one.plans_config = 2;
+
+  cur_plan_two.plans_config = 7;
+  if (!need_minimax) {
+    cur_plan_two.score.sum_score = 1e18;
+  }
+  for (int minimax_id = need_minimax ? 0 : 1; minimax_id < 2; ++minimax_id) {
+    auto& simulator = minimax_id == 0 ? simulator_two : simulator_one;
+    auto& cur_plan = minimax_id == 0 ? cur_plan_two : cur_plan_one;
+    evaluatePlan(simulator, cur_plan, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+  }
+#ifdef EVAL_CACHE
+  const Plan& result = std::min(cur_plan_one, cur_plan_two);
+  entry.world = world;
+  entry.key = key;
+  entry.take(result);
+  return result;
+#else
+  return std::min(cur_plan_one, cur_plan_two);
+#endif
+}
+
+// random plan, its score is min over both enemy plans configurations
+void searchIteration(
+    SmartSimulator& simulator_one,
+    SmartSimulator& simulator_two,
+    const bool need_minimax,
+    const int id,
+    const int iteration,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball,
+    const Plan* seed) {
+  PROFILE_ZONE(SEARCH);
+  const Plan& plan = randomPlan(simulator_one, id, iteration, seed);
+  H::best_plan[id] = std::max(H::best_plan[id], evaluateMinimax(
+      simulator_one, simulator_two, need_minimax, id, iteration, plan, ball_on_my_side, min_time_for_enemy_to_hit_the_ball));
+}
+
+#ifdef TREE_SEARCH
+
+// ground plan of two segments as a tree: the first segment is simulated once up to time_change,
+// C::TREE_BRANCHING second segments (direction, speed, jump) continue from simulator snapshots
+// returns number of evaluated plans, 0 if main robot is not on ground or plan has no shared prefix
+int treeSearchIteration(
+    SmartSimulator& simulator_one,
+    SmartSimulator& simulator_two,
+    const bool need_minimax,
+    const int id,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball) {
+  if (!simulator_one.main_robot->state.touch || simulator_one.main_robot->state.touch_surface_id != 1) {
+    return 0;
+  }
+  const double rd = C::rand_double(0, 1);
+  Plan prefix_plan(rd < 1. / 4 ? 20 : (rd < 2. / 4 ? 21 : (rd < 3. / 4 ? 22 : 23)), C::MAX_SIMULATION_DEPTH);
+  const int branch_tick = prefix_plan.time_change;
+  if (branch_tick < 1 || branch_tick >= C::MAX_SIMULATION_DEPTH) {
+    return 0;
+  }
+  if (H::role[id] == H::DEFENDER) {
+    prefix_plan.score.start_defender();
+  } else {
+    prefix_plan.score.start_fighter();
+  }
+
+  // index 0 - simulator_two, 1 - simulator_one, the same order as minimax of searchIteration
+  SmartSimulator* simulators[2] = {&simulator_two, &simulator_one};
+  Plan prefix[2];
+  Evaluation prefix_evaluation[2];
+  SmartSimulator::Snapshot snapshot[2];
+  const int first = need_minimax ? 0 : 1;
+  bool stopped = false;
+  for (int m = first; m < 2; ++m) {
+    prefix[m] = prefix_plan;
+    prefix[m].plans_config = m == 0 ? 7 : 2;
+    simulators[m]->initIteration(0, prefix_plan);
+    startEvaluation(*simulators[m], prefix_evaluation[m]);
+    evaluateTicks(*simulators[m], prefix[m], prefix_evaluation[m], 0, branch_tick, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+    simulators[m]->save(snapshot[m]);
+    stopped |= prefix_evaluation[m].stopped;
+  }
+
+  const int branches = stopped ? 1 : C::TREE_BRANCHING;
+  for (int branch = 0; branch < branches; ++branch) {
+    Plan branch_plan = prefix_plan;
+    if (branch > 0) {
+      branch_plan.unique_id = C::unique_plan_id++;
+      branch_plan.rand_angle2();
+      branch_plan.speed2_1_or_0();
+      if (branch_plan.time_jump != C::NEVER) {
+        branch_plan.rand_time_jump(C::MAX_SIMULATION_DEPTH, branch_tick + 1);
+      }
+    }
+    Plan result[2];
+    for (int m = first; m < 2; ++m) {
+      result[m] = branch_plan;
+      result[m].takeEvaluation(prefix[m]);
+      Evaluation evaluation = prefix_evaluation[m];
+      if (branch > 0) {
+        simulators[m]->restore(snapshot[m]);
+      }
+      simulators[m]->main_robot->plan = branch_plan;
+      evaluateTicks(*simulators[m], result[m], evaluation, branch_tick, C::MAX_SIMULATION_DEPTH, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+      finishEvaluation(result[m], evaluation);
+    }
+    if (!need_minimax) {
+      result[0] = result[1];
+    }
+    H::best_plan[id] = std::max(H::best_plan[id], std::min(result[1], result[0]));
+  }
+  return branches;
+}
+
+#endif
+
+#ifdef JUMP_SWEEP
+
+// all jump times of a movement plan in one pass: the plan without jump is simulated tick by tick,
+// on every tick main robot stands on ground in both simulators a fork with time_jump = tick continues to the end from snapshot
+// returns the best of the jumps and the plan without jump, evaluated - number of scored plans
+Plan sweepJumpTimes(
+    SmartSimulator& simulator_one,
+    SmartSimulator& simulator_two,
+    const bool need_minimax,
+    const int id,
+    const Plan& movement,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball,
+    int& evaluated) {
+  Plan trunk_plan = movement;
+  trunk_plan.time_jump = C::NEVER;
+
+  // index 0 - simulator_two, 1 - simulator_one, the same order as minimax of searchIteration
+  SmartSimulator* simulators[2] = {&simulator_two, &simulator_one};
+  Plan trunk[2];
+  Evaluation trunk_evaluation[2];
+  const int first = need_minimax ? 0 : 1;
+  for (int m = first; m < 2; ++m) {
+    trunk[m] = trunk_plan;
+    trunk[m].plans_config = m == 0 ? 7 : 2;
+    simulators[m]->initIteration(0, trunk_plan);
+    startEvaluation(*simulators[m], trunk_evaluation[m]);
+  }
+
+  Plan best;
+  best.score.minimal();
+  evaluated = 0;
+  SmartSimulator::Snapshot snapshot;
+  for (int sim_tick = 0; sim_tick < C::MAX_SIMULATION_DEPTH; ++sim_tick) {
+    // the jump must be possible in both minimax simulators, contacts with enemies differ between them
+    bool can_jump = true;
+    for (int m = first; m < 2; ++m) {
+      const auto& main_robot = simulators[m]->main_robot;
+      can_jump &= main_robot->state.touch && main_robot->state.touch_surface_id == 1;
+    }
+    Plan result[2];
+    for (int m = first; m < 2; ++m) {
+      if (can_jump) {
+        Plan jump_plan = trunk_plan;
+        jump_plan.time_jump = sim_tick;
+        result[m] = jump_plan;
+        result[m].takeEvaluation(trunk[m]);
+        Evaluation evaluation = trunk_evaluation[m];
+        simulators[m]->save(snapshot);
+        simulators[m]->main_robot->plan = jump_plan;
+        evaluateTicks(*simulators[m], result[m], evaluation, sim_tick, C::MAX_SIMULATION_DEPTH, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+        finishEvaluation(result[m], evaluation);
+        simulators[m]->restore(snapshot);
+        simulators[m]->main_robot->plan = trunk_plan;
+      }
+      evaluateTicks(*simulators[m], trunk[m], trunk_evaluation[m], sim_tick, sim_tick + 1, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+    }
+    if (can_jump) {
+      if (!need_minimax) {
+        result[0] = result[1];
+      }
+      best = std::max(best, std::min(result[1], result[0]));
+      evaluated++;
+    }
+  }
+  for (int m = first; m < 2; ++m) {
+    finishEvaluation(trunk[m], trunk_evaluation[m]);
+  }
+  if (!need_minimax) {
+    trunk[0] = trunk[1];
+  }
+  evaluated++;
+  return std::max(best, std::min(trunk[1], trunk[0]));
+}
+
+// random movement of a ground configuration with jump, jump time comes from the sweep
+// returns number of evaluated plans, 0 if main robot is not on ground
+int jumpSweepIteration(
+    SmartSimulator& simulator_one,
+    SmartSimulator& simulator_two,
+    const bool need_minimax,
+    const int id,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball) {
+  if (!simulator_one.main_robot->state.touch || simulator_one.main_robot->state.touch_surface_id != 1) {
+    return 0;
+  }
+  static constexpr int configurations[5] = {11, 12, 21, 22, 23};
+  Plan movement(configurations[C::rand_int(0, 4)], C::MAX_SIMULATION_DEPTH);
+  if (H::role[id] == H::DEFENDER) {
+    movement.score.start_defender();
+  } else {
+    movement.score.start_fighter();
+  }
+  int evaluated;
+  H::best_plan[id] = std::max(H::best_plan[id], sweepJumpTimes(
+      simulator_one, simulator_two, need_minimax, id, movement, ball_on_my_side, min_time_for_enemy_to_hit_the_ball, evaluated));
+  return evaluated;
+}
+
+#endif
+
+#ifdef SCREENING
+
+// two-stage step: C::SCREENING_CANDIDATES random plans are scored by the coarse simulator (main robot and ball only),
+// C::SCREENING_TOP_K best of them by coarse score get full fidelity minimax evaluation
+// returns number of full fidelity evaluations
+int screeningIteration(
+    SmartSimulator& simulator_one,
+    SmartSimulator& simulator_two,
+    SmartSimulator& simulator_coarse,
+    const bool need_minimax,
+    const int id,
+    const int iteration,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball) {
+  Plan top[C::SCREENING_TOP_K]; // not evaluated plans, by coarse score descending
+  double top_coarse_score[C::SCREENING_TOP_K];
+  int top_size = 0;
+  for (int candidate = 0; candidate < C::SCREENING_CANDIDATES; ++candidate) {
+    const Plan& plan = randomPlan(simulator_one, id, iteration, nullptr);
+    Plan coarse_plan = plan;
+    simulator_coarse.initIteration(iteration, coarse_plan);
+    evaluatePlan(simulator_coarse, coarse_plan, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+    const double coarse_score = coarse_plan.score.score();
+    if (top_size == C::SCREENING_TOP_K && coarse_score <= top_coarse_score[top_size - 1]) {
+      continue;
+    }
+    int pos = top_size < C::SCREENING_TOP_K ? top_size++ : top_size - 1;
+    for (; pos > 0 && top_coarse_score[pos - 1] < coarse_score; --pos) {
+      top[pos] = top[pos - 1];
+      top_coarse_score[pos] = top_coarse_score[pos - 1];
+    }
+    top[pos] = plan;
+    top_coarse_score[pos] = coarse_score;
+  }
+
+  double fine_score[C::SCREENING_TOP_K];
+  int fine_best = 0;
+  for (int i = 0; i < top_size; ++i) {
+    const Plan& result = evaluateMinimax(
+        simulator_one, simulator_two, need_minimax, id, iteration, top[i], ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+    fine_score[i] = result.score.score();
+    if (fine_score[i] > fine_score[fine_best]) {
+      fine_best = i;
+    }
+    H::best_plan[id] = std::max(H::best_plan[id], result);
+  }
+
+  H::screening_batches++;
+  H::screening_top_misses += fine_best != 0;
+  for (int i = 0; i < top_size; ++i) {
+    for (int j = i + 1; j < top_size; ++j) {
+      H::screening_pairs++;
+      H::screening_inversions += fine_score[i] < fine_score[j];
+    }
+  }
+  return top_size;
+}
+
+#endif
+
+// one step of the search loop, returns number of evaluated plans
+int searchStep(
+    SmartSimulator& simulator_one,
+    SmartSimulator& simulator_two,
+    const bool need_minimax,
+    const int id,
+    const int iteration,
+    const bool ball_on_my_side,
+    const int min_time_for_enemy_to_hit_the_ball,
+    const Plan* seed,
+#ifdef SCREENING
+    SmartSimulator* simulator_coarse) {
+  if (iteration >= 2 && simulator_coarse != nullptr) {
+    return screeningIteration(simulator_one, simulator_two, *simulator_coarse, need_minimax, id, iteration, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+  }
+#else
+    SmartSimulator* /* simulator_coarse, SCREENING only */) {
+#endif
+#ifdef JUMP_SWEEP
+  if (iteration >= 2 && C::rand_double(0, 1) < C::JUMP_SWEEP_SHARE) {
+    const int evaluated = jumpSweepIteration(simulator_one, simulator_two, need_minimax, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+    if (evaluated > 0) {
+      return evaluated;
+    }
+  }
+#endif
+#ifdef TREE_SEARCH
+  // about the steps randomPlan gives to 20-23 plans, 11/12 plans and mutations of the best plan keep their share
+  if (iteration >= 2 && C::rand_double(0, 1) < C::TREE_SEARCH_SHARE) {
+    const int evaluated = treeSearchIteration(simulator_one, simulator_two, need_minimax, id, ball_on_my_side, min_time_for_enemy_to_hit_the_ball);
+    if (evaluated > 0) {
+      return evaluated;
+    }
+  }
+#endif
+  searchIteration(simulator_one, simulator_two, need_minimax, id, iteration, ball_on_my_side, min_time_for_enemy_to_hit_the_ball, seed);
+  return 1;
+}
+
+// iterations and time limits of teammates search on decision tick, time limits are cumulative over teammates
+// the whole tick is split between teammates, so a smaller team gets more per robot
+struct SearchBudget {
+  int min_iterations[3];
+  int max_iterations[3];
+  int iterations[3]; // deterministic mode
+  double available_time[3] = {0, 0, 0};
+  double available_time_prefix[3];
+  double start = H::global_timer.getCumulative();
+
+  SearchBudget() {
+    for (int i = 0; i < H::team_size; ++i) {
+      min_iterations[i] = 150 * 2 * 3 / H::team_size;
+      max_iterations[i] = 400 * 2 * 3 / H::team_size;
+      iterations[i] = 200 * 2 * 3 / H::team_size;
+      available_time_prefix[i] = start + (i + 1) * H::cur_tick_remaining_time / H::team_size;
+    }
+  }
+
+  // defender gets little, fighters get the rest
+  void ballOnEnemySide() {
+    const int& fighters = H::team_size - 1;
+    for (int i = 0; i < H::team_size; ++i) {
+      if (H::role[i] == H::DEFENDER) {
+        available_time[i] = 0.1 * H::cur_tick_remaining_time;
+        iterations[i] = 50 * 2;
+        min_iterations[i] = 50 * 2;
+        max_iterations[i] = 50 * 2;
+      } else {
+        iterations[i] = 275 * 2 * 2 / fighters;
+        min_iterations[i] = 200 * 2 * 2 / fighters;
+        max_iterations[i] = 575 * 2 * 2 / fighters;
+        available_time[i] = 0.9 / fighters * H::cur_tick_remaining_time;
+      }
+    }
+    start = H::global_timer.getCumulative();
+    for (int i = 0; i < H::team_size; ++i) {
+      available_time_prefix[i] = i == 0 ? (start + available_time[i]) : (available_time[i] + available_time_prefix[i - 1]);
+    }
+  }
+};
+
+bool ballOnMySide(SmartSimulator& simulator_one, SmartSimulator& simulator_two) {
+  if (simulator_one.ball_on_trajectory && simulator_two.ball_on_trajectory) {
+    return BallTrajectory::onMySide(C::MAX_SIMULATION_DEPTH);
+  }
+  for (int i = 0; i < C::MAX_SIMULATION_DEPTH; ++i) {
+    if (simulator_one.ball->states[i].position.z < -0.01
+        || simulator_two.ball->states[i].position.z < -0.01) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#ifdef JOINT_PLANNING
+
+// search state of one teammate between rounds of joint planning
+struct JointRobot {
+  std::unique_ptr<SmartSimulator> simulator_one;
+  std::unique_ptr<SmartSimulator> simulator_two;
+  std::unique_ptr<SmartSimulator> simulator_coarse;
+  bool need_minimax;
+  int iteration = 0;
+  int built_with[3]; // unique ids of teammates best plans the simulators were built with
+};
+
+// teammates are searched in up to C::JOINT_ROUNDS short rounds, every round is a scaled copy of the usual schedule,
+// so in the next round a robot sees best plans of this tick of the robots searched after it
+// simulators are rebuilt only if best plan of another teammate changed since they were built,
+// own best plan is evaluated again on new simulators, search stops after a round without changes of best plans
+void jointSearch(
+    SearchBudget& budget,
+    bool& ball_on_my_side,
+    const int* credit,
+    const Plan* const* seed,
+    const int min_time_for_enemy_to_hit_the_ball,
+    int* iterations_done) {
+  JointRobot robots[3];
+  int rounds = 0;
+  bool converged = false;
+  for (int round = 0; round < C::JOINT_ROUNDS && !converged; ++round) {
+    rounds++;
+    converged = round > 0;
+    for (int id = 0; id < H::team_size; id++) {
+      auto& robot = robots[id];
+      bool rebuild = !robot.simulator_one;
+      for (int j = 0; j < H::team_size; ++j) {
+        rebuild |= j != id && robot.simulator_one && robot.built_with[j] != H::best_plan[j].unique_id;
+      }
+      if (rebuild) {
+        const bool first_build = !robot.simulator_one;
+        robot.simulator_one.reset(new SmartSimulator(false, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 2, H::game.robots, H::game.ball, H::game.nitro_packs));
+        robot.simulator_two.reset(new SmartSimulator(false, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 7, H::game.robots, H::game.ball, H::game.nitro_packs));
+#ifdef SCREENING
+        if (first_build) {
+          robot.simulator_coarse.reset(new SmartSimulator(true, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 2, H::game.robots, H::game.ball, {}));
+        }
+#endif
+        robot.need_minimax = (robot.simulator_one->ball->state.position - robot.simulator_two->ball->state.position).length() > 1e-9;
+        for (int j = 0; j < H::team_size; ++j) {
+          robot.built_with[j] = H::best_plan[j].unique_id;
+        }
+        if (first_build && id == 0) {
+          ball_on_my_side = ballOnMySide(*robot.simulator_one, *robot.simulator_two);
+          if (!ball_on_my_side) {
+            budget.ballOnEnemySide();
+          }
+        }
+        if (!first_build) { // score of best plan was got with old plans of teammates
+          H::best_plan[id].clearEvaluation();
+          searchIteration(*robot.simulator_one, *robot.simulator_two, robot.need_minimax, id, 0, ball_on_my_side, min_time_for_enemy_to_hit_the_ball, nullptr);
+          robot.iteration++;
+        }
+      }
+
+      const int best_before = H::best_plan[id].unique_id;
+      const double& span = budget.available_time_prefix[H::team_size - 1] - budget.start;
+      const double& round_end = budget.start + (round * span + budget.available_time_prefix[id] - budget.start) / C::JOINT_ROUNDS;
+      const int& round_iterations = budget.iterations[id] * (round + 1) / C::JOINT_ROUNDS;
+      const int& round_min_iterations = budget.min_iterations[id] * (round + 1) / C::JOINT_ROUNDS;
+      const int& round_max_iterations = budget.max_iterations[id] * (round + 1) / C::JOINT_ROUNDS;
+      int& iteration = robot.iteration;
+      while (H::deterministic ? iteration < round_iterations : (iteration < 2 || iteration + credit[id] < round_min_iterations
+          || (iteration + credit[id] < round_max_iterations
+              && H::global_timer.getCumulative(true) < round_end))) {
+        iteration += searchStep(*robot.simulator_one, *robot.simulator_two, robot.need_minimax, id, iteration, ball_on_my_side,
+                                min_time_for_enemy_to_hit_the_ball, iteration == 1 ? seed[id] : nullptr, robot.simulator_coarse.get());
+      }
+      converged &= H::best_plan[id].unique_id == best_before;
+    }
+  }
+  for (int id = 0; id < H::team_size; id++) {
+    iterations_done[id] = robots[id].iteration;
+  }
+  H::addJointStats(rounds, converged);
+}
+
+#endif
+
+#ifdef SPECULATIVE
+
+void fillRobot(model::Robot& robot, const EntityState& state) {
+  robot.x = state.position.x;
+  robot.y = state.position.y;
+  robot.z = state.position.z;
+  robot.velocity_x = state.velocity.x;
+  robot.velocity_y = state.velocity.y;
+  robot.velocity_z = state.velocity.z;
+  robot.radius = state.radius;
+  robot.nitro_amount = state.nitro;
+  robot.touch = state.touch;
+  robot.touch_normal_x = state.touch_normal.x;
+  robot.touch_normal_y = state.touch_normal.y;
+  robot.touch_normal_z = state.touch_normal.z;
+}
+
+// state of the next decision tick: one tick with current best plans for us and last action plans for enemies
+model::Game predictNextGame() {
+  model::Game next = H::game;
+  next.current_tick++;
+  SmartSimulator simulator(false, 1, 1, H::getRobotGlobalIdByLocal(0), 2, H::game.robots, H::game.ball, H::game.nitro_packs);
+  simulator.initIteration(0, H::best_plan[0]);
+  simulator.tickDynamic(0);
+  for (auto& robot : next.robots) {
+    if (robot.id == simulator.main_robot->id) {
+      fillRobot(robot, simulator.main_robot->state);
+    }
+    for (int i = 0; i < simulator.initial_static_robots_size; ++i) {
+      const auto& e = simulator.initial_static_robots[i];
+      if (robot.id == e->id) {
+        fillRobot(robot, e->is_dynamic ? e->state : e->states[1]);
+      }
+    }
+  }
+  const EntityState& ball = simulator.ball->is_dynamic ? simulator.ball->state : simulator.ball->states[1];
+  next.ball.x = ball.position.x;
+  next.ball.y = ball.position.y;
+  next.ball.z = ball.position.z;
+  next.ball.velocity_x = ball.velocity.x;
+  next.ball.velocity_y = ball.velocity.y;
+  next.ball.velocity_z = ball.velocity.z;
+  return next;
+}
+
+bool closeTo(const double& x, const double& y, const double& z, const double& other_x, const double& other_y, const double& other_z, const double& eps) {
+  return Point{x - other_x, y - other_y, z - other_z}.length_sq() < eps * eps;
+}
+
+// speculative scores still apply if the real state is close to predicted one
+bool speculationFits() {
+  const auto& predicted = H::spec_game;
+  if (predicted.robots.size() != H::game.robots.size()) {
+    return false;
+  }
+  for (int i = 0; i < (int) H::game.robots.size(); ++i) {
+    const auto& a = predicted.robots[i];
+    const auto& b = H::game.robots[i];
+    if (a.id != b.id
+        || !closeTo(a.x, a.y, a.z, b.x, b.y, b.z, C::SPECULATION_POSITION_EPS)
+        || !closeTo(a.velocity_x, a.velocity_y, a.velocity_z, b.velocity_x, b.velocity_y, b.velocity_z, C::SPECULATION_VELOCITY_EPS)) {
+      return false;
+    }
+  }
+  const auto& a = predicted.ball;
+  const auto& b = H::game.ball;
+  return closeTo(a.x, a.y, a.z, b.x, b.y, b.z, C::SPECULATION_POSITION_EPS)
+      && closeTo(a.velocity_x, a.velocity_y, a.velocity_z, b.velocity_x, b.velocity_y, b.velocity_z, C::SPECULATION_VELOCITY_EPS);
+}
+
+// worker thread: the same search as on decision tick, but from predicted state
+// main thread only waits for the server meanwhile, globals are restored at the end
+// spec_stop is checked before every expensive stage, the main thread joins the worker before its next tick
+void speculativeSearch() {
+  const double start_time = CPUTime::getThreadCPUTime();
+  const double budget = H::cur_tick_remaining_time;
+  const model::Game saved_game = H::game;
+  Plan saved_best_plan[6];
+  H::ROLE saved_role[6];
+  for (int i = 0; i < 6; ++i) {
+    saved_best_plan[i] = H::best_plan[i];
+    saved_role[i] = H::role[i];
+  }
+
+  H::spec_robots = 0;
+  H::spec_game = predictNextGame();
+  H::game = H::spec_game;
+  updateRoles();
+  clearBestPlans();
+  BallTrajectory::build(H::game.ball);
+  const int min_time_for_enemy_to_hit_the_ball = H::spec_stop ? C::NEVER : predictEnemies();
+
+  bool ball_on_my_side = false;
+  for (int id = 0; id < H::team_size; id++) {
+    if (H::spec_stop) {
+      break;
+    }
+    SmartSimulator simulator_one(false, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 2, H::game.robots, H::game.ball, H::game.nitro_packs);
+    SmartSimulator simulator_two(false, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 7, H::game.robots, H::game.ball, H::game.nitro_packs);
+    SmartSimulator* simulator_coarse = nullptr;
+#ifdef SCREENING
+    SmartSimulator coarse(true, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 2, H::game.robots, H::game.ball, {});
+    simulator_coarse = &coarse;
+#endif
+    const bool need_minimax = (simulator_one.ball->state.position - simulator_two.ball->state.position).length() > 1e-9;
+    if (id == 0) {
+      ball_on_my_side = ballOnMySide(simulator_one, simulator_two);
+    }
+    int iteration = 0;
+    while (!H::spec_stop && CPUTime::getThreadCPUTime() - start_time < budget * (id + 1) / H::team_size) {
+      iteration += searchStep(simulator_one, simulator_two, need_minimax, id, iteration, ball_on_my_side, min_time_for_enemy_to_hit_the_ball, nullptr, simulator_coarse);
+    }
+    H::spec_best_plan[id] = H::best_plan[id];
+    H::spec_iterations[id] = iteration;
+    H::spec_role[id] = H::role[id];
+    H::spec_robots = id + 1;
+  }
+  H::spec_tick = H::spec_game.current_tick;
+
+  H::game = saved_game;
+  for (int i = 0; i < 6; ++i) {
+    H::best_plan[i] = saved_best_plan[i];
+    H::role[i] = saved_role[i];
+  }
+  H::spec_cpu_time = CPUTime::getThreadCPUTime() - start_time;
+}
+
+// after the last act of the tick before decision tick
+void startSpeculation() {
+  H::spec_tick = -1;
+  H::spec_stop = false;
+  H::spec_worker = std::thread(speculativeSearch);
+}
+
+// before timing of the next tick starts, worker time is charged to the global budget
+void finishSpeculation() {
+  if (!H::spec_worker.joinable()) {
+    return;
+  }
+  H::spec_stop = true;
+  H::spec_worker.join();
+  H::global_timer.cumulative += H::spec_cpu_time;
+}
+
+#endif
+
 void doStrategy() {
+  PROFILE_ZONE(STRATEGY);
 #ifdef FROM_LOG
   for (auto& robot: H::game.robots) {
     Entity e;
@@ -335,6 +1201,14 @@ void doStrategy() {
   P::drawEntities({e.state}, 0, 0x333333);
 #endif
 
+#ifdef LOCAL
+  if (H::tick == 0) {
+    const int& mismatches = Dan::validateArenaGeometry(100000);
+    if (mismatches > 0) {
+      std::cerr << "arena geometry mismatches: " << mismatches << std::endl;
+    }
+  }
+#endif
 
   //todo saving packs collisions
 
@@ -348,36 +1222,77 @@ void doStrategy() {
     //P::logn("cur: ", H::cur_tick_remaining_time);
     //P::logn("sum: ", H::global_timer.getCumulative(true));
 
-    //for (int i = 0; i < 100; ++i) {
-    //  auto& t = H::t[i];
-    //  t.clearCur();
-    //}
-    //for (int i = 0; i < 100; ++i) {
-    //  auto& c = H::c[i];
-    //  c.init_calls();
-    //}
-
-    //H::t[0].start();
-
     updateRoles();
 
     clearBestPlans();
 
+    BallTrajectory::build(H::game.ball);
+
+#ifdef ADAPTIVE_FIDELITY
+    FidelityMonitor::check();
+    H::trigger_limit = FidelityMonitor::trigger_limits[FidelityMonitor::level];
+#endif
+
+#ifdef TELEMETRY
+    Telemetry::Record& record = Telemetry::next();
+    record.tick = H::tick;
+    record.budget = H::cur_tick_remaining_time;
+    const double& strategy_start = CPUTime::getCPUTime();
+#endif
+
     int min_time_for_enemy_to_hit_the_ball = enemiesPrediction();
     int cur_iterations = 0;
 
-    int min_iterations[3] = {150 * 2, 150 * 2, 150 * 2};
-    int max_iterations[3] = {400 * 2, 400 * 2, 400 * 2};
-    int iterations[3] = {200 * 2, 200 * 2, 200 * 2};
+#ifdef TELEMETRY
+    record.enemies_prediction = CPUTime::getCPUTime() - strategy_start;
+#endif
+
+#ifdef SPECULATIVE
+    const bool speculation_ready = H::spec_tick == H::tick;
+    const bool speculation_fits = speculation_ready && speculationFits();
+#endif
+
     //P::logn(H::cur_tick_remaining_time);
-    double available_time[3] = {0, 0, 0};
-    double available_time_prefix[3] = {H::global_timer.getCumulative() + H::cur_tick_remaining_time / 3, H::global_timer.getCumulative() + 2 * H::cur_tick_remaining_time / 3, H::global_timer.getCumulative() + H::cur_tick_remaining_time};
+    SearchBudget budget;
+
+    int credit[3] = {0, 0, 0}; // iterations already done by speculative search
+    const Plan* seed[3] = {nullptr, nullptr, nullptr};
+#ifdef SPECULATIVE
+    for (int id = 0; id < H::team_size; id++) {
+      if (speculation_ready && id < H::spec_robots) {
+        seed[id] = &H::spec_best_plan[id];
+        if (speculation_fits && H::spec_role[id] == H::role[id]) {
+          credit[id] = H::spec_iterations[id];
+        }
+      }
+    }
+#endif
 
     bool ball_on_my_side = false;
-    for (int id = 0; id < 3; id++) {
+#ifdef JOINT_PLANNING
+    int iterations_done[3];
+    jointSearch(budget, ball_on_my_side, credit, seed, min_time_for_enemy_to_hit_the_ball, iterations_done);
+    for (int id = 0; id < H::team_size; id++) {
+      cur_iterations += iterations_done[id];
+      H::sum_iterations += iterations_done[id];
+      H::search_iterations += iterations_done[id];
+#ifdef TELEMETRY
+      record.iterations[id] = iterations_done[id];
+      record.configuration[id] = H::best_plan[id].configuration;
+      record.role[id] = H::role[id];
+      record.best_score[id] = H::best_plan[id].score.score();
+#endif
+    }
+#else
+    for (int id = 0; id < H::team_size; id++) {
       int iteration = 0;
       SmartSimulator simulator_one(false, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 2, H::game.robots, H::game.ball, H::game.nitro_packs);
       SmartSimulator simulator_two(false, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 7, H::game.robots, H::game.ball, H::game.nitro_packs);
+      SmartSimulator* simulator_coarse = nullptr;
+#ifdef SCREENING
+      SmartSimulator coarse(true, C::TPT, C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 2, H::game.robots, H::game.ball, {});
+      simulator_coarse = &coarse;
+#endif
 
       bool need_minimax = false;
       if ((1 || simulator_one.static_goal_to_me
@@ -407,213 +1322,26 @@ void doStrategy() {
       */
 
       if (id == 0) {
-        for (int i = 0; i < C::MAX_SIMULATION_DEPTH; ++i) {
-          if (simulator_one.ball->states[i].position.z < -0.01
-              || simulator_two.ball->states[i].position.z < -0.01) {
-            ball_on_my_side = true;
-          }
-        }
+        ball_on_my_side = ballOnMySide(simulator_one, simulator_two);
         if (!ball_on_my_side) {
-          for (int i = 0; i < 3; ++i) {
-            if (H::role[i] == H::DEFENDER) {
-              available_time[i] = 0.1 * H::cur_tick_remaining_time;
-              iterations[i] = 50 * 2;
-              min_iterations[i] = 50 * 2;
-              max_iterations[i] = 50 * 2;
-            } else {
-              iterations[i] = 275 * 2;
-              min_iterations[i] = 200 * 2;
-              max_iterations[i] = 575 * 2;
-              available_time[i] = 0.45 * H::cur_tick_remaining_time;
-            }
-          }
-          for (int i = 0; i < 3; ++i) {
-            available_time_prefix[i] = i == 0 ? (H::global_timer.getCumulative() + available_time[i]) : (available_time[i] + available_time_prefix[i - 1]);
-          }
+          budget.ballOnEnemySide();
         }
       }
 
-      for (;iteration < min_iterations[id]
-          || (iteration < max_iterations[id]
-              && H::global_timer.getCumulative(true) < available_time_prefix[id]); iteration++) {
-      // for (; iteration < iterations[id]; iteration++) {
-        int plan_type;
-        double rd = C::rand_double(0, 1);
-
-        if (simulator_one.main_robot->state.touch
-            && simulator_one.main_robot->state.touch_surface_id == 1) {
-          if (rd < 1. / 7) {
-            plan_type = 20;
-          } else if (rd < 2. / 7) {
-            plan_type = 21;
-          } else if (rd < 3. / 7) {
-            plan_type = 22;
-          } else if (rd < 4. / 7) {
-            plan_type = 23;
-          } else if (rd < 5. / 7) {
-            plan_type = 11;
-          } else if (rd < 6. / 7) {
-            plan_type = 12;
-          } else {
-            plan_type = 11;
-          }
-        } else {
-          if (rd < 0.8) {
-            plan_type = 31;
-          } else {
-            plan_type = 32;
-          }
-        }
-
-        Plan cur_plan_one(plan_type, C::MAX_SIMULATION_DEPTH);
-        if (iteration == 0) {
-          cur_plan_one = H::best_plan[id];
-        } else if (C::rand_double(0, 1) < 1. / 10.) { // todo check coefficient
-          cur_plan_one = H::best_plan[id];
-          cur_plan_one.mutate(cur_plan_one.configuration, C::MAX_SIMULATION_DEPTH);
-        }
-
-        if (H::role[id] == H::FIGHTER) {
-          cur_plan_one.score.start_fighter();
-        } else if (H::role[id] == H::SEMI) {
-          cur_plan_one.score.start_fighter();
-        } else if (H::role[id] == H::DEFENDER) {
-          cur_plan_one.score.start_defender();
-        }
-
-
-        simulator_one.initIteration(iteration, cur_plan_one);
-
-        Plan cur_plan_two = cur_plan_one;
-
-        simulator_two.initIteration(iteration, cur_plan_two);
-
-        cur_plan_one.plans_config = 2;
-
-        cur_plan_two.plans_config = 7;
-        if (!need_minimax) {
-          cur_plan_two.score.sum_score = 1e18;
-        }
-        for (int minimax_id = need_minimax ? 0 : 1; minimax_id < 2; ++minimax_id) {
-          auto& simulator = minimax_id == 0 ? simulator_two : simulator_one;
-          auto& cur_plan = minimax_id == 0 ? cur_plan_two : cur_plan_one;
-
-          double multiplier = 1.;
-          double goal_multiplier = 1.;
-
-          bool collide_with_smth = false;
-          bool fly_on_prefix = (!simulator.main_robot->state.touch || simulator.main_robot->state.touch_surface_id != 1);
-
-          for (int sim_tick = 0; sim_tick < C::MAX_SIMULATION_DEPTH; sim_tick++) {
-
-            bool main_touch = (simulator.main_robot->state.touch && simulator.main_robot->state.touch_surface_id == 1) || simulator.main_robot->state.position.y < C::NITRO_TOUCH_EPSILON;
-
-            int main_robot_additional_jump_type = simulator.tickDynamic(sim_tick, H::getRobotGlobalIdByLocal(0), false);
-
-            fly_on_prefix &= (!simulator.main_robot->state.touch || simulator.main_robot->state.touch_surface_id != 1);
-
-            if (main_robot_additional_jump_type == 0 && simulator.main_robot->action.jump_speed > 0 && main_touch) {
-              cur_plan.was_jumping = true;
-            }
-
-            if (main_robot_additional_jump_type > 0) { // 1 - with ball, 2 - with entity, 3 - additional
-              if (fly_on_prefix &&
-                  (main_robot_additional_jump_type == 1 || main_robot_additional_jump_type == 2)) {
-                collide_with_smth = true;
-              }
-              if ((main_robot_additional_jump_type == 1 || main_robot_additional_jump_type == 2)
-                  && cur_plan.was_jumping
-                  && !cur_plan.was_on_ground_after_jumping
-                  && !cur_plan.collide_with_entity_before_on_ground_after_jumping) {
-                cur_plan.collide_with_entity_before_on_ground_after_jumping = true;
-                if (H::role[id] == H::DEFENDER && main_robot_additional_jump_type == 1
-                    && min_time_for_enemy_to_hit_the_ball < sim_tick
-                    && cur_plan.time_jump <= min_time_for_enemy_to_hit_the_ball) {
-                  cur_plan.score.minimal();
-                  break;
-                }
-                if (sim_tick - cur_plan.time_jump > C::LONGEST_JUMP) {
-                  cur_plan.score.minimal();
-                  break;
-                }
-              }
-              if (cur_plan.oncoming_jump == C::NEVER) {
-                cur_plan.oncoming_jump = sim_tick;
-                cur_plan.oncoming_jump_speed = main_robot_additional_jump_type == 3 ?
-                    std::max(C::MIN_WALL_JUMP, cur_plan.max_jump_speed) : cur_plan.max_jump_speed;
-              }
-            }
-
-            if (cur_plan.was_jumping && !cur_plan.was_on_ground_after_jumping && simulator.main_robot->state.touch) {
-              cur_plan.was_on_ground_after_jumping = true;
-              if (!cur_plan.collide_with_entity_before_on_ground_after_jumping) {
-                cur_plan.score.minimal();
-                break;
-              }
-            }
-
-            if (H::role[id] == H::FIGHTER) {
-              cur_plan.score.sum_score += simulator.getSumScoreFighter(sim_tick, goal_multiplier, ball_on_my_side, true) * multiplier;
-              cur_plan.score.fighter_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_ball);
-              cur_plan.score.fighter_min_dist_to_goal = std::min(simulator.getMinDistToGoalScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_goal);
-              cur_plan.score.fighter_closest_enemy_ever = std::min(simulator.getMinDistToEnemyScore() * multiplier, cur_plan.score.fighter_closest_enemy_ever);
-              if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
-                cur_plan.score.fighter_last_dist_to_goal = simulator.getMinDistToGoalScoreFighter();
-              }
-              if (sim_tick == C::ENEMY_LIVE_TICKS - 1) {
-                cur_plan.score.fighter_closest_enemy_last = simulator.getMinDistToEnemyScore();
-              }
-            } else if (H::role[id] == H::DEFENDER) {
-              cur_plan.score.sum_score += simulator.getSumScoreDefender(sim_tick, ball_on_my_side) * multiplier;
-              cur_plan.score.defender_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreDefender() * multiplier, cur_plan.score.defender_min_dist_to_ball);
-              cur_plan.score.defender_min_dist_from_goal = std::min(simulator.getMinDistFromGoalScoreDefender() * multiplier, cur_plan.score.defender_min_dist_from_goal);
-              if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
-                cur_plan.score.defender_last_dist_from_goal = simulator.getMinDistFromGoalScoreDefender();
-              }
-            } else if (H::role[id] == H::SEMI) {
-              cur_plan.score.sum_score += simulator.getSumScoreFighter(sim_tick, goal_multiplier, ball_on_my_side, false) * multiplier;
-              cur_plan.score.fighter_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_ball);
-              cur_plan.score.fighter_min_dist_to_goal = std::min(simulator.getMinDistToGoalScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_goal);
-              cur_plan.score.fighter_closest_enemy_ever = std::min(simulator.getMinDistToEnemyScore() * multiplier, cur_plan.score.fighter_closest_enemy_ever);
-              if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
-                cur_plan.score.fighter_last_dist_to_goal = simulator.getMinDistToGoalScoreFighter();
-              }
-              if (sim_tick == C::ENEMY_LIVE_TICKS - 1) {
-                cur_plan.score.fighter_closest_enemy_last = simulator.getMinDistToEnemyScore();
-              }
-            }
-
-            multiplier *= 0.999;
-            const double g_mult = 0.85;
-            goal_multiplier *= g_mult * g_mult;
-          }
-
-          if (!collide_with_smth) {
-            cur_plan.time_nitro_on = C::NEVER;
-            cur_plan.time_nitro_off = C::NEVER;
-          }
-
-          if (!cur_plan.was_jumping) {
-            cur_plan.time_jump = C::NEVER;
-          } else if (cur_plan.was_jumping && !cur_plan.collide_with_entity_before_on_ground_after_jumping) {
-            cur_plan.score.minimal();
-          } else {
-            if (cur_plan.oncoming_jump == C::NEVER) {
-              cur_plan.oncoming_jump = cur_plan.time_jump;
-              cur_plan.oncoming_jump_speed = cur_plan.max_jump_speed;
-            } else if (cur_plan.time_jump != C::NEVER) {
-              if (cur_plan.oncoming_jump > cur_plan.time_jump) {
-                cur_plan.oncoming_jump = cur_plan.time_jump;
-                cur_plan.oncoming_jump_speed = cur_plan.max_jump_speed;
-              }
-            }
-          }
-        }
-
-        H::best_plan[id] = std::max(H::best_plan[id], std::min(cur_plan_one, cur_plan_two));
+      while (H::deterministic ? iteration < budget.iterations[id] : (iteration < 2 || iteration + credit[id] < budget.min_iterations[id]
+          || (iteration + credit[id] < budget.max_iterations[id]
+              && H::global_timer.getCumulative(true) < budget.available_time_prefix[id]))) {
+        iteration += searchStep(simulator_one, simulator_two, need_minimax, id, iteration, ball_on_my_side, min_time_for_enemy_to_hit_the_ball, iteration == 1 ? seed[id] : nullptr, simulator_coarse);
       }
       cur_iterations += iteration;
       H::sum_iterations += iteration;
+      H::search_iterations += iteration;
+#ifdef TELEMETRY
+      record.iterations[id] = iteration;
+      record.configuration[id] = H::best_plan[id].configuration;
+      record.role[id] = H::role[id];
+      record.best_score[id] = H::best_plan[id].score.score();
+#endif
 #ifdef DEBUG
       if (H::role[id] == H::DEFENDER) {
         P::logn("best plan id: ", H::best_plan[id].unique_id);
@@ -667,6 +1395,15 @@ void doStrategy() {
       }
 #endif
     }
+#endif
+#ifdef ADAPTIVE_FIDELITY
+    FidelityMonitor::predict();
+#endif
+#ifdef TELEMETRY
+    record.used = CPUTime::getCPUTime() - strategy_start;
+    record.global_time = H::global_timer.getCumulative(true);
+    Telemetry::takeTriggerFires(record);
+#endif
     H::min_iterations = std::min(H::min_iterations, (double)cur_iterations);
     H::max_iterations = std::max(H::max_iterations, (double)cur_iterations);
     H::iterations_k += 1;
@@ -698,18 +1435,7 @@ void doStrategy() {
     //}
 #endif
 
-    //H::t[0].cur(true);
-    //for (int i = 0; i < 5; ++i) {
-    //  auto& t = H::t[i];
-    //  t.cur(false, true);
-    //  P::logn("t", i, " avg: ", t.avg() * 1000, " cur: ", t.getCur() * 1000, " x", (int)(std::floor(t.getCur() / t.avg() * 100)), "%");
-    //}
 
-    //for (int i = 0; i < 5; ++i) {
-    //  auto& c = H::c[i];
-    //  c.capture();
-    //  P::logn("c", i, " avg: ", c.avg_(), " cur: ", c.last_(), " x", (int)(std::floor((double)c.last_() / c.avg_() * 100)), "%");
-    //}
   }
 
   for (auto& robot : H::game.robots) {
@@ -724,417 +1450,34 @@ void doStrategy() {
 #endif
 }
 
-MyStrategy::MyStrategy() {}
-
-#ifndef LOCAL
-namespace Frozen {
-void clearBestPlans() {
-  for (int id = 0; id < 2; id++) {
-    H::best_plan[id].clearAndShift(C::MAX_SIMULATION_DEPTH);
-  }
-  for (int id = 2; id < 4; id++) {
-    H::best_plan[id].clearAndShift(C::ENEMY_SIMULATION_DEPTH);
-  }
-}
-
-void enemiesPrediction() {
-
-  for (int id = 0; id < 4; ++id) {
-    for (auto& robot : H::game.robots) {
-      if (robot.id == H::getRobotGlobalIdByLocal(id)) {
-        H::last_action_plan[id] = Plan(4, C::MAX_SIMULATION_DEPTH, robot.velocity_x, robot.velocity_z);
-      }
-    }
-  }
-
-  for (int id = 0; id < 4; ++id) {
-    for (auto& robot : H::game.robots) {
-      if (robot.id == H::getRobotGlobalIdByLocal(id)) {
-        Point v0 = H::prev_velocity[id];
-        Point v1 = {robot.velocity_x, robot.velocity_y, robot.velocity_z};
-        double dvx = v1.x - v0.x;
-        double dvz = v1.z - v0.z;
-        double ax, az;
-        if (H::solve(v0.x, v0.z, v1.x, v1.z, dvx, dvz, ax, az)) {
-
-          Point2d cur{ax, az};
-          Point2d prev = H::prev_last_action[H::getRobotLocalIdByGlobal(robot.id)];
-
-          Point p0 = H::prev_position[id];
-          Point p1 = {robot.x, robot.y, robot.z};
-          //P::drawLine(p1, {p1.x + dvx * 30, 1, p1.z + dvz * 30}, 0x0000FF);
-          Point crossing;
-          //P::drawLine({p0.x, 1, p0.z}, {p0.x + prev.x, 1, p0.z + prev.y}, 0xFF0000);
-          //P::drawLine({p1.x, 1, p1.z}, {p1.x + cur.x, 1, p1.z + cur.y}, 0xFF0000);
-          if (0 && H::solve2(
-              {p0.x, p0.z},
-              {p0.x + prev.x, p0.z + prev.y},
-              {p1.x, p1.z},
-              {p1.x + cur.x, p1.z + cur.y},
-              crossing)) {
-            //P::logn("kek");
-            //P::drawLine(p0, crossing, 0xFF0000);
-            //P::drawLine(p1, crossing, 0xFF0000);
-            H::last_action_plan[id] = Plan(5, C::MAX_SIMULATION_DEPTH, ax, az, crossing.x, crossing.z);
-          } else {
-
-            H::last_action_plan[id] = Plan(4, C::MAX_SIMULATION_DEPTH, ax, az);
-
-          }
-          //if (!robot.is_teammate) {
-          //  P::logn(robot.id, " ", sqrt(ax * ax + az * az));
-          //  P::drawLine(p1, {p1.x + ax, p1.y, p1.z + az}, 0xFFFFFF);
-          //}
-
-          H::prev_last_action[H::getRobotLocalIdByGlobal(robot.id)] = {ax, az};
-
-        }
-      }
-    }
-  }
-
-  const int enemy_depth = 50;
-
-  for (int enemy_id : {2, 3}) {
-    continue;
-    SmartSimulator simulator(enemy_depth, H::getRobotGlobalIdByLocal(enemy_id), 3, H::game.robots, H::game.ball, {});
-
-    for (int iteration = 0; iteration < 100; iteration++) {
-      Plan cur_plan(2, enemy_depth);
-      if (iteration == 0) {
-        cur_plan = H::best_plan[enemy_id];
-      } else if (C::rand_double(0, 1) < 1. / 10.) {
-        cur_plan = H::best_plan[enemy_id];
-        cur_plan.mutate(2, enemy_depth);
-      }
-      cur_plan.score.start_fighter();
-      simulator.initIteration(iteration, cur_plan);
-
-      cur_plan.plans_config = 3;
-      double multiplier = 1.;
-      for (int sim_tick = 0; sim_tick < enemy_depth; sim_tick++) {
-        /*int cell_x = std::clamp((int) ((simulator.main_robot->state.position.x + 40.) / 2.), 1, 78);
-        int cell_y = std::clamp((int) ((simulator.main_robot->state.position.y + 1.) / 2.), 1, 18);
-        int cell_z = std::clamp((int) ((simulator.main_robot->state.position.z + 30.) / 2.), 1, 58);
-        H::danger_grid[cell_x + 1][cell_y][cell_z][sim_tick]++;
-        H::used_cells[H::used_cells_size++] = {cell_x + 1, cell_y, cell_z, sim_tick};
-        H::danger_grid[cell_x][cell_y + 1][cell_z][sim_tick]++;
-        H::used_cells[H::used_cells_size++] = {cell_x, cell_y + 1, cell_z, sim_tick};
-        H::danger_grid[cell_x][cell_y][cell_z + 1][sim_tick]++;
-        H::used_cells[H::used_cells_size++] = {cell_x, cell_y, cell_z + 1, sim_tick};
-
-        H::danger_grid[cell_x - 1][cell_y][cell_z][sim_tick]++;
-        H::used_cells[H::used_cells_size++] = {cell_x - 1, cell_y, cell_z, sim_tick};
-        H::danger_grid[cell_x][cell_y - 1][cell_z][sim_tick]++;
-        H::used_cells[H::used_cells_size++] = {cell_x, cell_y - 1, cell_z, sim_tick};
-        H::danger_grid[cell_x][cell_y][cell_z - 1][sim_tick]++;
-        H::used_cells[H::used_cells_size++] = {cell_x, cell_y, cell_z - 1, sim_tick};
-        */
-        simulator.tickDynamic(sim_tick);
-
-        cur_plan.score.sum_score += simulator.getSumScoreEnemy(sim_tick) * multiplier;
-        cur_plan.score.fighter_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreEnemy() * multiplier, cur_plan.score.fighter_min_dist_to_ball);
-        cur_plan.score.fighter_min_dist_to_goal = std::min(simulator.getMinDistToGoalScoreEnemy() * multiplier, cur_plan.score.fighter_min_dist_to_goal);
-        if (sim_tick == enemy_depth - 1) {
-          cur_plan.score.fighter_last_dist_to_goal = simulator.getMinDistToGoalScoreEnemy();
-        }
-
-        multiplier *= 0.999;
-      }
-      H::best_plan[enemy_id] = std::max(H::best_plan[enemy_id], cur_plan);
-    }
-    /*if (enemy_id == 3) {
-      Plan cur_plan = H::best_plan[enemy_id];
-
-      SmartSimulator simulator_(
-          C::MAX_SIMULATION_DEPTH,
-          H::getRobotGlobalIdByLocal(enemy_id),
-          cur_plan.plans_config,
-          H::game.robots,
-          H::game.ball,
-          {},
-          false,
-          H::getRobotGlobalIdByLocal(enemy_id));
-      simulator_.initIteration(250, cur_plan);
-
-      for (int sim_tick = 0; sim_tick < C::MAX_SIMULATION_DEPTH; sim_tick++) {
-        simulator_.tickDynamic(sim_tick, H::getRobotGlobalIdByLocal(enemy_id), true);
-      }
-    }*/
-  }
-}
-
-void doStrategy() {
-#ifdef FROM_LOG
-  for (auto& robot: H::game.robots) {
-    Entity e;
-    e.fromRobot(robot);
-    P::drawEntities({e.state}, 0, e.is_teammate ? 0x00FF00 : 0xFF0000);
-  }
-  for (auto& nitro_pack : H::game.nitro_packs) {
-    Entity e;
-    e.fromPack(nitro_pack);
-    P::drawEntities({e.state}, 0, 0x0000FF);
-  }
-  Entity e;
-  e.fromBall(H::game.ball);
-  P::drawEntities({e.state}, 0, 0x333333);
+MyStrategy::MyStrategy() {
+  H::warmUp();
+#ifdef TELEMETRY
+  Telemetry::init();
 #endif
+}
 
-
-  //todo saving packs collisions
-
-  //for (int i = 0; i < 100; ++i) {
-  //  auto& t = H::t[i];
-  //  t.clearCur();
-  //}
-  //for (int i = 0; i < 100; ++i) {
-  //  auto& c = H::c[i];
-  //  c.init_calls();
-  //}
-  //H::t[0].start();
-
-  if (H::tick % C::TPT == 0) {
-
-    clearBestPlans();
-
-    enemiesPrediction();
-
-    int iterations[2] = {250 + 1, 250 + 1};
-    for (int id = 1; id >= 0; id--) {
-      int iteration = 0;
-      SmartSimulator simulator_smart(C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 1, H::game.robots, H::game.ball, H::game.nitro_packs);
-      SmartSimulator simulator_stupid(C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), 2, H::game.robots, H::game.ball, H::game.nitro_packs);
-
-      bool ball_on_my_side = false;
-      if (id == 1) {
-        for (int i = 0; i < C::MAX_SIMULATION_DEPTH; ++i) {
-          if (simulator_smart.ball->states[i].position.z < -0.01 || simulator_stupid.ball->states[i].position.z < -0.01) {
-            ball_on_my_side = true;
-          }
-        }
-        if (!ball_on_my_side) {
-          iterations[0] = 475 + 1;
-          iterations[1] = 25 + 1;
-        }
-      }
-
-      for (; H::global_timer.getCumulative(true) < H::time_limit; iteration++) {
-        if (id == 1) {
-          if (ball_on_my_side) {
-            if (H::global_timer.getCumulative(true) > H::half_time) {
-              break;
-            }
-          } else {
-            if (H::global_timer.cur() > 0.002) {
-              break;
-            }
-          }
-        }
-        /*for (;; iteration++) {
-          if (iteration > iterations[id]) {
-            break;
-          }*/
-        Plan cur_plan_smart(1, C::MAX_SIMULATION_DEPTH);
-        if (iteration == 0) {
-          cur_plan_smart = H::best_plan[id];
-        } else if (C::rand_double(0, 1) < 1. / 10.) { // todo check coefficient
-          cur_plan_smart = H::best_plan[id];
-          cur_plan_smart.mutate(1, C::MAX_SIMULATION_DEPTH);
-        }
-
-        if (id == 0) {
-          cur_plan_smart.score.start_fighter();
-        } else {
-          cur_plan_smart.score.start_defender();
-        }
-
-        simulator_smart.initIteration(iteration, cur_plan_smart);
-
-        Plan cur_plan_stupid = cur_plan_smart;
-
-        simulator_stupid.initIteration(iteration, cur_plan_stupid);
-
-        cur_plan_smart.plans_config = 1;
-        cur_plan_stupid.plans_config = 2;
-
-        cur_plan_smart.score.sum_score += 1e18;
-        for (int minimax = 1; minimax < 2; ++minimax) {
-          auto& simulator = minimax == 0 ? simulator_smart : simulator_stupid;
-          auto& cur_plan = minimax == 0 ? cur_plan_smart : cur_plan_stupid;
-          double multiplier = 1.;
-          for (int sim_tick = 0; sim_tick < C::MAX_SIMULATION_DEPTH; sim_tick++) {
-
-            bool main_touch = simulator.main_robot->state.touch;
-
-            int main_robot_additional_jump_type = simulator.tickDynamic(sim_tick, H::getRobotGlobalIdByLocal(0), false);
-
-            if (main_robot_additional_jump_type == 0 && simulator.main_robot->action.jump_speed > 0 && main_touch) {
-              cur_plan.was_jumping = true;
-            }
-
-            if (main_robot_additional_jump_type > 0) { // 1 - with ball, 2 - with entity, 3 - additional
-              if ((main_robot_additional_jump_type == 1 || main_robot_additional_jump_type == 2) && cur_plan.was_jumping && !cur_plan.was_on_ground_after_jumping) {
-                cur_plan.collide_with_entity_before_on_ground_after_jumping = true;
-              }
-              if (cur_plan.oncoming_jump == C::NEVER) {
-                cur_plan.oncoming_jump = sim_tick;
-                cur_plan.oncoming_jump_speed = main_robot_additional_jump_type == 3 ?
-                    std::max(C::MIN_WALL_JUMP, cur_plan.max_jump_speed) : cur_plan.max_jump_speed;
-              }
-            }
-
-            if (cur_plan.was_jumping && !cur_plan.was_on_ground_after_jumping && simulator.main_robot->state.touch) {
-              cur_plan.was_on_ground_after_jumping = true;
-              if (!cur_plan.collide_with_entity_before_on_ground_after_jumping) {
-                cur_plan.time_jump = C::NEVER;
-              }
-            }
-
-            if (id == 0) {
-              cur_plan.score.sum_score += simulator.getSumScoreFighter(sim_tick) * multiplier;
-              cur_plan.score.fighter_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_ball);
-              cur_plan.score.fighter_min_dist_to_goal = std::min(simulator.getMinDistToGoalScoreFighter() * multiplier, cur_plan.score.fighter_min_dist_to_goal);
-              if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
-                cur_plan.score.fighter_last_dist_to_goal = simulator.getMinDistToGoalScoreFighter();
-              }
-            } else if (id == 1) {
-              cur_plan.score.sum_score += simulator.getSumScoreDefender(sim_tick) * multiplier;
-              cur_plan.score.defender_min_dist_to_ball = std::min(simulator.getMinDistToBallScoreDefender() * multiplier, cur_plan.score.defender_min_dist_to_ball);
-              cur_plan.score.defender_min_dist_from_goal = std::min(simulator.getMinDistFromGoalScoreDefender() * multiplier, cur_plan.score.defender_min_dist_from_goal);
-              if (sim_tick == C::MAX_SIMULATION_DEPTH - 1) {
-                cur_plan.score.defender_last_dist_from_goal = simulator.getMinDistFromGoalScoreDefender();
-              }
-            }
-            multiplier *= 0.999;
-          }
-
-          if (cur_plan.was_jumping && !cur_plan.collide_with_entity_before_on_ground_after_jumping) {
-            cur_plan.time_jump = C::NEVER;
-          } else {
-
-            if (cur_plan.oncoming_jump == C::NEVER) {
-              cur_plan.oncoming_jump = cur_plan.time_jump;
-              cur_plan.oncoming_jump_speed = cur_plan.max_jump_speed;
-            } else if (cur_plan.time_jump != C::NEVER) {
-              if (cur_plan.oncoming_jump > cur_plan.time_jump) {
-                cur_plan.oncoming_jump = cur_plan.time_jump;
-                cur_plan.oncoming_jump_speed = cur_plan.max_jump_speed;
-              }
-            }
-          }
-        }
-        H::best_plan[id] = std::max(H::best_plan[id], std::min(cur_plan_smart, cur_plan_stupid));
-      }
-
-      H::sum_asserts_failed += iteration;
-#ifdef DEBUG
-      if (id == 0) {
-        P::logn("best plan id: ", H::best_plan[id].unique_id);
-        P::logn("fighter score: ", H::best_plan[id].score.score());
-        P::logn("sum_score: ", H::best_plan[id].score.sum_score);
-        P::logn("fighter_min_dist_to_ball: ", -H::best_plan[id].score.fighter_min_dist_to_ball);
-        P::logn("fighter_min_dist_to_goal: ", -H::best_plan[id].score.fighter_min_dist_to_goal);
-        P::logn("fighter_last_dist_to_goal: ", -H::best_plan[id].score.fighter_last_dist_to_goal);
-        P::logn("time_jump: ", H::best_plan[id].time_jump);
-        P::logn("oncoming_jump: ", H::best_plan[id].oncoming_jump);
-        P::logn("oncoming_jump_speed: ", H::best_plan[id].oncoming_jump_speed);
-        P::logn("max_jump_speed: ", H::best_plan[id].max_jump_speed);
-        P::logn("angle1: ", H::best_plan[id].angle1);
-        P::logn("speed1: ", H::best_plan[id].speed1);
-        P::logn("time_change: ", H::best_plan[id].time_change);
-        P::logn("angle2: ", H::best_plan[id].angle2);
-        P::logn("speed2: ", H::best_plan[id].speed2);
-        P::logn("was_jumping: ", H::best_plan[id].was_jumping);
-        P::logn("was_jumping: ", H::best_plan[id].was_jumping);
-        P::logn("collide_with_entity_before_on_ground_after_jumping: ", H::best_plan[id].collide_with_entity_before_on_ground_after_jumping);
-        P::logn("was_on_ground_after_jumping: ", H::best_plan[id].was_on_ground_after_jumping);
-
-
-        Plan cur_plan = H::best_plan[id];
-
-        SmartSimulator simulator(C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), cur_plan.plans_config, H::game.robots, H::game.ball, H::game.nitro_packs, false, H::getRobotGlobalIdByLocal(id));
-        simulator.initIteration(iteration, cur_plan);
-
-        SmartSimulator accurate_simulator(C::MAX_SIMULATION_DEPTH, H::getRobotGlobalIdByLocal(id), cur_plan.plans_config, H::game.robots, H::game.ball, H::game.nitro_packs, true, H::getRobotGlobalIdByLocal(id));
-        accurate_simulator.initIteration(iteration, cur_plan);
-
-        for (int sim_tick = 0; sim_tick < C::MAX_SIMULATION_DEPTH; sim_tick++) {
-          simulator.tickDynamic(sim_tick, H::getRobotGlobalIdByLocal(id), true);
-          accurate_simulator.tickDynamic(sim_tick, H::getRobotGlobalIdByLocal(id), true);
-        }
-      }
+MyStrategy::~MyStrategy() {
+#ifdef SPECULATIVE
+  finishSpeculation();
 #endif
-    }
-    H::asserts_failed_k += 1;
-  }
-
-#ifndef FROM_LOG
-  for (auto& robot : H::game.robots) {
-    if (robot.is_teammate) {
-      Entity e;
-      e.fromRobot(robot);
-      e.action = H::best_plan[H::getRobotLocalIdByGlobal(robot.id)].toMyAction(0, false, true, e.state.position);
-      e.nitroCheck();
-      if (!e.action.use_nitro) {
-        e.action = H::best_plan[H::getRobotLocalIdByGlobal(robot.id)].toMyAction(0, false, false, e.state.position);
-      }
-      H::actions[robot.id] = e.action.toAction();
-    }
-  }
+  PROFILE_DUMP();
+#ifdef TELEMETRY
+  Telemetry::flush();
 #endif
-
-  for (auto& robot : H::game.robots) {
-    int id = H::getRobotLocalIdByGlobal(robot.id);
-    H::prev_velocity[id] = {robot.velocity_x, robot.velocity_y, robot.velocity_z};
-    H::prev_position[id] = {robot.x, robot.y, robot.z};
-  }
-
-  //H::t[0].cur(true);
-  //for (int i = 0; i < 7; ++i) {
-  //  auto& t = H::t[i];
-  //  t.cur(false, true);
-  //  P::logn("t", i, " avg: ", t.avg() * 1000, " cur: ", t.getCur() * 1000, " x", (int)(std::floor(t.getCur() / t.avg() * 100)), "%");
-  //}
-
-  //for (int i = 0; i < 5; ++i) {
-  //  auto& c = H::c[i];
-  //  c.capture();
-  //  P::logn("c", i, " avg: ", c.avg_(), " cur: ", c.last_(), " x", (int)(std::floor((double)c.last_() / c.avg_() * 100)), "%");
-  //}
-
-}
 }
-#endif
+
 void MyStrategy::act(
     const model::Robot& me,
     const model::Rules& rules,
     const model::Game& game,
     model::Action& action) {
-#ifndef LOCAL
-  if (rules.team_size == 3) {
-    int init = H::tryInit(me, rules, game);
-  if (init == 1) {
-    doStrategy();
-    action = H::getCurrentAction();
-  } else if (init == 2) {
-    action = H::getCurrentAction();
-  } else if (init == 3) {
-    action = H::getCurrentAction();
-    H::global_timer.cur(true, true);
-  }
-  } else {
-      if (Frozen::H::tryInit(me, rules, game)) {
-      Frozen::doStrategy();
-      action = Frozen::H::getCurrentAction();
-    } else {
-      action = Frozen::H::getCurrentAction();
-      Frozen::H::global_timer.cur(true, true);
-    }
-  }
-#else
+#ifdef SPECULATIVE
+  finishSpeculation();
+#endif
   int init = H::tryInit(me, rules, game);
   if (init == 1) {
+    PROFILE_END_TICK();
     doStrategy();
     action = H::getCurrentAction();
   } else if (init == 2) {
@@ -1142,79 +1485,85 @@ void MyStrategy::act(
   } else if (init == 3) {
     action = H::getCurrentAction();
     H::global_timer.cur(true, true);
-  }
+#ifdef SPECULATIVE
+    if (!H::deterministic && H::waiting_ticks == 0 && H::cur_round_tick >= 0 && H::cur_round_tick % C::TPT == C::TPT - 1) {
+      startSpeculation();
+    }
 #endif
+  }
 }
 
 #ifdef LOCAL
 #ifdef DRAWLR
 
-#include "rapidjson/stringbuffer.h"
-#include "rapidjson/writer.h"
-
-std::string MyStrategy::custom_rendering() {
-  rapidjson::Document document;
-  document.SetArray();
-  rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
-  for (auto line : P::lines_to_draw) {
-    rapidjson::Value line_object;
-    line_object.SetObject();
-    rapidjson::Value line_data;
-    line_data.SetObject();
-    line_data.AddMember("x1", line.a.x, allocator);
-    line_data.AddMember("y1", line.a.y, allocator);
-    line_data.AddMember("z1", line.a.z, allocator);
-    line_data.AddMember("x2", line.b.x, allocator);
-    line_data.AddMember("y2", line.b.y, allocator);
-    line_data.AddMember("z2", line.b.z, allocator);
-    line_data.AddMember("width", 1.0, allocator);
-    line_data.AddMember("r", line.getR(), allocator);
-    line_data.AddMember("g", line.getG(), allocator);
-    line_data.AddMember("b", line.getB(), allocator);
-    line_data.AddMember("a", line.getA(), allocator);
-    line_object.AddMember("Line", line_data, allocator);
-    document.PushBack(line_object, allocator);
+void MyStrategy::custom_rendering(rapidjson::Writer<rapidjson::StringBuffer>& writer) {
+  writer.StartArray();
+  for (auto& line : P::lines_to_draw) {
+    writer.StartObject();
+    writer.Key("Line");
+    writer.StartObject();
+    writer.Key("x1");
+    writer.Double(line.a.x);
+    writer.Key("y1");
+    writer.Double(line.a.y);
+    writer.Key("z1");
+    writer.Double(line.a.z);
+    writer.Key("x2");
+    writer.Double(line.b.x);
+    writer.Key("y2");
+    writer.Double(line.b.y);
+    writer.Key("z2");
+    writer.Double(line.b.z);
+    writer.Key("width");
+    writer.Double(1.0);
+    writer.Key("r");
+    writer.Double(line.getR());
+    writer.Key("g");
+    writer.Double(line.getG());
+    writer.Key("b");
+    writer.Double(line.getB());
+    writer.Key("a");
+    writer.Double(line.getA());
+    writer.EndObject();
+    writer.EndObject();
   }
-  for (auto sphere : P::spheres_to_draw) {
-    rapidjson::Value sphere_object;
-    sphere_object.SetObject();
-    rapidjson::Value sphere_data;
-    sphere_data.SetObject();
-    sphere_data.AddMember("x", sphere.center.x, allocator);
-    sphere_data.AddMember("y", sphere.center.y, allocator);
-    sphere_data.AddMember("z", sphere.center.z, allocator);
-    sphere_data.AddMember("radius", sphere.radius, allocator);
-    sphere_data.AddMember("r", sphere.getR(), allocator);
-    sphere_data.AddMember("g", sphere.getG(), allocator);
-    sphere_data.AddMember("b", sphere.getB(), allocator);
-    sphere_data.AddMember("a", sphere.getA(), allocator);
-    sphere_object.AddMember("Sphere", sphere_data, allocator);
-    document.PushBack(sphere_object, allocator);
+  for (auto& sphere : P::spheres_to_draw) {
+    writer.StartObject();
+    writer.Key("Sphere");
+    writer.StartObject();
+    writer.Key("x");
+    writer.Double(sphere.center.x);
+    writer.Key("y");
+    writer.Double(sphere.center.y);
+    writer.Key("z");
+    writer.Double(sphere.center.z);
+    writer.Key("radius");
+    writer.Double(sphere.radius);
+    writer.Key("r");
+    writer.Double(sphere.getR());
+    writer.Key("g");
+    writer.Double(sphere.getG());
+    writer.Key("b");
+    writer.Double(sphere.getB());
+    writer.Key("a");
+    writer.Double(sphere.getA());
+    writer.EndObject();
+    writer.EndObject();
   }
 
   for (auto& log : P::logs) {
-    rapidjson::Value log_object;
-    log_object.SetObject();
-    rapidjson::Value value;
-    value.SetString(log.c_str(), allocator);
-    log_object.AddMember("Text", value, allocator);
-    document.PushBack(log_object, allocator);
+    writer.StartObject();
+    writer.Key("Text");
+    writer.String(log.c_str(), (rapidjson::SizeType) log.size());
+    writer.EndObject();
   }
-
-  rapidjson::StringBuffer buf;
-  rapidjson::Writer<rapidjson::StringBuffer> writer(buf);
-  document.Accept(writer);
+  writer.EndArray();
 
   if (H::cur_round_tick % C::TPT == C::TPT - 1) {
     P::logs.clear();
     P::lines_to_draw.clear();
     P::spheres_to_draw.clear();
   }
-  //if (H::tick == 3900) {
-  return buf.GetString();
-  //} else {
-  //  return {};
-  //}
 }
 
 #endif
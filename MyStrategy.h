@@ -10,9 +10,12 @@
 class MyStrategy : public Strategy {
 public:
     MyStrategy();
+    ~MyStrategy() override;
 
     void act(const model::Robot& me, const model::Rules& rules, const model::Game& game, model::Action& action) override;
-    std::string custom_rendering() override;
+#ifdef DRAWLR
+    void custom_rendering(rapidjson::Writer<rapidjson::StringBuffer>& writer) override;
+#endif
 };
 
 #endif
@@ -0,0 +1,121 @@
+#ifdef LOCAL
+
+#include <OpponentModel.h>
+
+#else
+
+#include "OpponentModel.h"
+
+#endif
+
+OpponentModel::Slot OpponentModel::slots[3];
+
+int OpponentModel::distanceBin(const double& distance) {
+  return distance < 6 ? 0 : (distance < 20 ? 1 : 2);
+}
+
+void OpponentModel::ballFrame(const model::Robot& robot, Point2d& toward, Point2d& side, double& distance) {
+  const Point2d& to_ball = Point2d{H::game.ball.x - robot.x, H::game.ball.z - robot.z};
+  distance = to_ball.length();
+  toward = distance > 1e-9 ? to_ball / distance : Point2d{0, 1};
+  side = {-toward.y, toward.x};
+  const Point2d& to_goal = Point2d{-robot.x, C::rules.arena.depth / 2 - robot.z};
+  if (side.dot(to_goal) < 0) {
+    side = side * -1;
+  }
+}
+
+bool OpponentModel::modelTarget(const Slot& slot, const model::Robot& robot, Point2d& target) {
+  Point2d toward, side;
+  double distance;
+  ballFrame(robot, toward, side, distance);
+  const int& bin = distanceBin(distance);
+  if (slot.samples[bin] < C::OPPONENT_MODEL_MIN_SAMPLES) {
+    return false;
+  }
+  target = (toward * slot.toward[bin] + side * slot.side[bin]).clamp(C::rules.ROBOT_MAX_GROUND_SPEED);
+  return true;
+}
+
+void OpponentModel::observeGround(const int& id, const model::Robot& robot, const Point2d& target) {
+  auto& slot = slots[id - H::team_size];
+  slot.in_air = false;
+  const Point& position = {robot.x, robot.y, robot.z};
+  if ((position - H::prev_position[id]).length_sq() > 25) { // respawn after goal, target is not solved from real move
+    slot.history_size = 0;
+    return;
+  }
+
+  // every kept prediction is checked, a prediction without ready model is the last action plan itself
+  if (slot.history_size > 0) {
+    double last_action_error = 0, model_error = 0;
+    for (int i = 0; i < slot.history_size; ++i) {
+      const auto& prediction = slot.history[i];
+      const double& error = (prediction.last_action - target).length_sq();
+      last_action_error += error;
+      model_error += prediction.model_ready ? (prediction.model - target).length_sq() : error;
+    }
+    last_action_error /= slot.history_size;
+    model_error /= slot.history_size;
+    if (slot.checks == 0) {
+      slot.last_action_error = last_action_error;
+      slot.model_error = model_error;
+    } else {
+      slot.last_action_error += C::OPPONENT_MODEL_RATE * (last_action_error - slot.last_action_error);
+      slot.model_error += C::OPPONENT_MODEL_RATE * (model_error - slot.model_error);
+    }
+    slot.checks++;
+  }
+
+  Point2d toward, side;
+  double distance;
+  ballFrame(robot, toward, side, distance);
+  const int& bin = distanceBin(distance);
+  if (slot.samples[bin] == 0) {
+    slot.toward[bin] = target.dot(toward);
+    slot.side[bin] = target.dot(side);
+  } else {
+    slot.toward[bin] += C::OPPONENT_MODEL_RATE * (target.dot(toward) - slot.toward[bin]);
+    slot.side[bin] += C::OPPONENT_MODEL_RATE * (target.dot(side) - slot.side[bin]);
+  }
+  slot.samples[bin]++;
+
+  auto& prediction = slot.history[slot.history_head];
+  prediction.last_action = target;
+  prediction.model_ready = modelTarget(slot, robot, prediction.model);
+  slot.history_head = (slot.history_head + 1) % HISTORY;
+  slot.history_size = std::min(slot.history_size + 1, HISTORY);
+}
+
+void OpponentModel::observeFlight(const int& id, const model::Robot& robot, const bool& using_nitro) {
+  auto& slot = slots[id - H::team_size];
+  if (!slot.in_air && robot.velocity_y > 1) { // first tick of flight after the ground, takeoff from bumps is slower
+    const double& jump_speed = std::min(robot.velocity_y, C::rules.ROBOT_MAX_JUMP_SPEED);
+    slot.jump_speed = slot.jumps == 0 ? jump_speed : slot.jump_speed + C::OPPONENT_MODEL_RATE * (jump_speed - slot.jump_speed);
+    slot.jumps++;
+  }
+  slot.in_air = true;
+  if (robot.nitro_amount > 0) {
+    slot.nitro += C::OPPONENT_MODEL_RATE * ((using_nitro ? 1 : 0) - slot.nitro);
+  }
+}
+
+bool OpponentModel::predict(const int& id, const model::Robot& robot, Plan& last_action_plan, Plan& last_action0_plan) {
+  const auto& slot = slots[id - H::team_size];
+  H::opponent_predictions++;
+  Point2d target;
+  if (slot.checks < C::OPPONENT_MODEL_MIN_SAMPLES || slot.model_error >= slot.last_action_error
+      || !modelTarget(slot, robot, target)) {
+    return false;
+  }
+  // jump speed 0 means 15 for plan 73 as for 71
+  last_action_plan = Plan(73, C::MAX_SIMULATION_DEPTH, target.x, target.y, 0, 0, {0, 0, 0}, slot.jumps > 0 ? slot.jump_speed : 0, false);
+  if (robot.nitro_amount > 0 && slot.nitro > 0.5) { // nitro is used in flight only
+    last_action_plan.time_nitro_on = 0;
+    last_action_plan.time_nitro_off = C::MAX_SIMULATION_DEPTH;
+    last_action_plan.nitro_as_velocity = true;
+  }
+  last_action0_plan = Plan(730, C::MAX_SIMULATION_DEPTH, target.x, target.y, 0, 0, {0, 0, 0}, 0, false);
+  H::opponent_model_predictions++;
+  return true;
+}
@@ -0,0 +1,59 @@
+#ifndef CODEBALL_OPPONENTMODEL_H
+#define CODEBALL_OPPONENTMODEL_H
+
+#ifdef LOCAL
+#include <H.h>
+#else
+#include "H.h"
+#endif
+
+// online statistics of every enemy, target velocities are kept in the frame of the ball:
+// along the direction to the ball and across it towards the enemy goal, one pair per distance to the ball
+// a prediction from them replaces the last action plans (71/710) only while it explains the enemy better,
+// both are checked against the targets observed during the next C::OPPONENT_MODEL_HORIZON ticks
+struct OpponentModel {
+
+  static constexpr int DISTANCE_BINS = 3;
+  static constexpr int HISTORY = C::OPPONENT_MODEL_HORIZON / C::TPT;
+
+  struct Prediction {
+    Point2d last_action;
+    Point2d model;
+    bool model_ready;
+  };
+
+  struct Slot {
+    double toward[DISTANCE_BINS];
+    double side[DISTANCE_BINS];
+    int samples[DISTANCE_BINS];
+    double last_action_error; // mean squared target error of the last action during the horizon
+    double model_error;
+    int checks;
+    Prediction history[HISTORY];
+    int history_size;
+    int history_head;
+    double jump_speed; // observed at the first tick of flight
+    int jumps;
+    double nitro; // share of flight ticks with nitro while the enemy has some
+    bool in_air;
+  };
+
+  static Slot slots[3];
+
+  // enemy on the ground, target is the target velocity solved from the last velocity change
+  static void observeGround(const int& id, const model::Robot& robot, const Point2d& target);
+
+  static void observeFlight(const int& id, const model::Robot& robot, const bool& using_nitro);
+
+  // replaces both last action plans of the enemy if the model predicts better, false if plans are not changed
+  static bool predict(const int& id, const model::Robot& robot, Plan& last_action_plan, Plan& last_action0_plan);
+
+  static int distanceBin(const double& distance);
+
+  // unit direction to the ball and unit normal to it pointing to the enemy goal
+  static void ballFrame(const model::Robot& robot, Point2d& toward, Point2d& side, double& distance);
+
+  static bool modelTarget(const Slot& slot, const model::Robot& robot, Point2d& target);
+};
+
+#endif //CODEBALL_OPPONENTMODEL_H
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include "rapidjson/document.h"
 #include "rapidjson/writer.h"
 #include "rapidjson/stringbuffer.h"
@@ -11,40 +14,74 @@ using namespace rapidjson;
 
 const int32 BUFFER_SIZE = 8 * 1024;
 
-string RemoteProcessClient::readline() {
+// returned line is valid until next call, nullptr when connection is closed
+char* RemoteProcessClient::readline() {
     while (true) {
-        size_t eol = buffer.find('\n');
-        if (eol != string::npos) {
-            string line = buffer.substr(0, eol);
-            buffer = buffer.substr(eol + 1);
+        char* eol = static_cast<char*>(memchr(buffer.data() + buffer_scanned, '\n', buffer_end - buffer_scanned));
+        if (eol != nullptr) {
+            *eol = '\0';
+            char* line = buffer.data() + buffer_begin;
+            buffer_begin = buffer_scanned = eol - buffer.data() + 1;
             return line;
         }
+        buffer_scanned = buffer_end;
+        if (buffer_begin > 0) {
+            memmove(buffer.data(), buffer.data() + buffer_begin, buffer_end - buffer_begin);
+            buffer_end -= buffer_begin;
+            buffer_scanned -= buffer_begin;
+            buffer_begin = 0;
+        }
         int32 received = socket.Receive(BUFFER_SIZE);
         if (received < 0) {
             cerr << "Error reading from socket" << endl;
             exit(10002);
         }
         if (received == 0) {
-            return "";
+            return nullptr;
+        }
+        if (buffer.size() < buffer_end + received) {
+            buffer.resize(2 * (buffer_end + received));
         }
-        buffer.append(socket.GetData(), socket.GetData() + received);
+        memcpy(buffer.data() + buffer_end, socket.GetData(), received);
+        buffer_end += received;
     }
 }
 
+RemoteProcessClient::InsituDocument& RemoteProcessClient::parse(char* line) {
+    value_allocator->Clear();
+    stack_allocator->Clear();
+    document->ParseInsitu(line);
+    return *document;
+}
+
 void RemoteProcessClient::writeline(string line) {
     line.push_back('\n');
-    if (socket.Send(reinterpret_cast<const uint8*>(line.c_str()), static_cast<int32_t>(line.length())) < 0) {
+    send(line.c_str(), line.length());
+}
+
+void RemoteProcessClient::send(const char* data, size_t size) {
+    if (socket.Send(reinterpret_cast<const uint8*>(data), size) < 0) {
         cerr << "Failed to send data" << endl;
         exit(10003);
     }
 }
 
-RemoteProcessClient::RemoteProcessClient(string host, int port) {
+RemoteProcessClient::RemoteProcessClient(string host, int port)
+    : buffer(4 * BUFFER_SIZE), value_pool(POOL_SIZE), stack_pool(POOL_SIZE), send_writer(send_buffer) {
+    value_allocator.reset(new PoolAllocator(value_pool.data(), value_pool.size()));
+    stack_allocator.reset(new PoolAllocator(stack_pool.data(), stack_pool.size()));
+    document.reset(new InsituDocument(value_allocator.get(), 1024, stack_allocator.get()));
+
 #ifdef FROM_LOG
     fin = ifstream("logs/346639.log", std::ifstream::in);
     std::string wat;
     std::getline(fin, wat);
 #endif
+    const char* record_path = getenv("CODEBALL_RECORD");
+    if (record_path != nullptr && *record_path != '\0') {
+        record = fopen(record_path, "w");
+    }
+
     socket.Initialize();
     socket.DisableNagleAlgoritm();
 
@@ -56,55 +93,73 @@ RemoteProcessClient::RemoteProcessClient(string host, int port) {
     writeline("json");
 }
 
+RemoteProcessClient::~RemoteProcessClient() {
+    if (record != nullptr) {
+        fclose(record);
+    }
+}
+
 unique_ptr<Rules> RemoteProcessClient::read_rules() {
-    string line = readline();
-    if (line.empty()) {
+    char* line = readline();
+    if (line == nullptr || *line == '\0') {
         return unique_ptr<Rules>();
     }
-    Document d;
-    d.Parse(line.c_str());
+    if (record != nullptr) {
+        fprintf(record, "%s\n", line);
+    }
     unique_ptr<Rules> result(new Rules());
-    result->read(d);
+    result->read(parse(line));
 
     return result;
 }
 
-unique_ptr<Game> RemoteProcessClient::read_game() {
-    string line = readline();
-    if (line.empty()) {
-        return unique_ptr<Game>();
+bool RemoteProcessClient::read_game(Game& game) {
+    char* line = readline();
+    if (line == nullptr || *line == '\0') {
+        return false;
+    }
+    if (record != nullptr) {
+        fprintf(record, "%s\n", line);
     }
-    Document d;
-    d.Parse(line.c_str());
-    unique_ptr<Game> result(new Game());
-    result->read(d);
+#ifdef FROM_LOG
+    // read2 fills only what the log has (touch normals and respawn ticks are set only when present),
+    // so every tick starts from an empty game as it did before the game was reused
+    game = Game();
+#endif
+    game.read(parse(line));
 #ifdef FROM_LOG
     string line2;
     std::getline(fin, line2);
     if (line2.empty()) {
-        return unique_ptr<Game>();
+        return false;
     }
     Document d2;
     d2.Parse(line2.c_str());
-    unique_ptr<Game> result2(new Game());
-    result2->read2(d2);
-
-    return result2;
+    game.read2(d2);
 #endif
-    return result;
+    return true;
 }
 
-void RemoteProcessClient::write(const unordered_map<int, Action>& actions, const string& custom_rendering) {
-    Document d;
-    d.SetObject();
-    Document::AllocatorType& allocator = d.GetAllocator();
-    for (auto it : actions) {
-        d.AddMember(Value(to_string(it.first).c_str(), allocator).Move(), it.second.to_json(allocator).Move(), allocator);
+// actions|rendering\n<end>\n in one buffer and one send
+void RemoteProcessClient::write(const unordered_map<int, Action>& actions, Strategy& strategy) {
+    send_buffer.Clear();
+    send_writer.Reset(send_buffer);
+    send_writer.StartObject();
+    for (auto& it : actions) {
+        char key[16];
+        const int key_length = snprintf(key, sizeof(key), "%d", it.first);
+        send_writer.Key(key, static_cast<SizeType>(key_length));
+        it.second.write(send_writer);
+    }
+    send_writer.EndObject();
+    send_buffer.Put('|');
+    send_writer.Reset(send_buffer);
+    strategy.custom_rendering(send_writer);
+    const char end[] = "\n<end>\n";
+    for (const char* c = end; *c; ++c) {
+        send_buffer.Put(*c);
     }
-    StringBuffer buffer;
-    Writer<StringBuffer> writer(buffer);
-    d.Accept(writer);
-    writeline(string(buffer.GetString()) + "|" + custom_rendering + "\n<end>");
+    send(send_buffer.GetString(), send_buffer.GetSize());
 }
 
 void RemoteProcessClient::write_token(const string& token) {
@@ -9,24 +9,49 @@
 #include <memory>
 #include <string>
 #include <fstream>
+#include <vector>
 
 #include "csimplesocket/ActiveSocket.h"
 
 #include "model/Action.h"
 #include "model/Game.h"
 #include "model/Rules.h"
+#include "Strategy.h"
 
+// values and parser stack live in preallocated pools which are cleared every message,
+// lines are parsed in place inside the receive buffer, so reading a tick allocates nothing
 class RemoteProcessClient {
+    typedef rapidjson::MemoryPoolAllocator<> PoolAllocator;
+    typedef rapidjson::GenericDocument<rapidjson::UTF8<>, PoolAllocator, PoolAllocator> InsituDocument;
+
+    static const size_t POOL_SIZE = 256 * 1024;
+
     CActiveSocket socket;
-    std::string buffer;
-    std::string readline();
+    std::vector<char> buffer;
+    size_t buffer_begin = 0; // first unread byte
+    size_t buffer_scanned = 0; // no '\n' before this
+    size_t buffer_end = 0;
+    char* readline();
     std::ifstream fin;
+    FILE* record = nullptr; // received lines are copied here when CODEBALL_RECORD is set, for replay
+
+    std::vector<char> value_pool;
+    std::vector<char> stack_pool;
+    std::unique_ptr<PoolAllocator> value_allocator;
+    std::unique_ptr<PoolAllocator> stack_allocator;
+    std::unique_ptr<InsituDocument> document;
+    InsituDocument& parse(char* line);
+
+    rapidjson::StringBuffer send_buffer; // keeps capacity between ticks
+    rapidjson::Writer<rapidjson::StringBuffer> send_writer;
     void writeline(std::string line);
+    void send(const char* data, size_t size);
 public:
     RemoteProcessClient(std::string host, int port);
+    ~RemoteProcessClient();
     std::unique_ptr<model::Rules> read_rules();
-    std::unique_ptr<model::Game> read_game();
-    void write(const std::unordered_map<int, model::Action>& actions, const std::string& custom_rendering);
+    bool read_game(model::Game& game);
+    void write(const std::unordered_map<int, model::Action>& actions, Strategy& strategy);
     void write_token(const std::string& token);
 };
 
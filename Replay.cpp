@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rapidjson/document.h"
+
+#include "MyStrategy.h"
+#include "H.h"
+
+// deterministic replay of a game recorded with CODEBALL_RECORD=<file> CodeBall ...
+// strategy runs with fixed iteration counts, rolling hash of actions and best plan scores is printed per tick
+// replay <record> [--write baseline] [--check baseline] [--timed]
+// --check stops at the first tick where hash differs from baseline and exits with 1
+// --timed runs with the real time limits instead and prints search iterations per tick, builds are compared by it
+
+struct RollingHash {
+  uint64_t value = 14695981039346656037ull;
+
+  void add(const void* data, const size_t& size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+      value ^= bytes[i];
+      value *= 1099511628211ull;
+    }
+  }
+
+  void add(const double& x) {
+    add(&x, sizeof(x));
+  }
+};
+
+static void usage(const char* name) {
+  fprintf(stderr, "usage: %s <record> [--write baseline] [--check baseline] [--timed]\n", name);
+  exit(2);
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    usage(argv[0]);
+  }
+  std::string write_path, check_path;
+  bool timed = false;
+  for (int i = 2; i < argc; ++i) {
+    const std::string& arg = argv[i];
+    if (arg == "--write" && i + 1 < argc) {
+      write_path = argv[++i];
+    } else if (arg == "--check" && i + 1 < argc) {
+      check_path = argv[++i];
+    } else if (arg == "--timed") {
+      timed = true;
+    } else {
+      usage(argv[0]);
+    }
+  }
+
+  std::ifstream in(argv[1]);
+  std::string line;
+  if (!std::getline(in, line)) {
+    fprintf(stderr, "empty record %s\n", argv[1]);
+    return 2;
+  }
+  rapidjson::Document document;
+  document.Parse(line.c_str());
+  model::Rules rules;
+  rules.read(document);
+
+  std::unordered_map<int, uint64_t> baseline;
+  if (!check_path.empty()) {
+    FILE* f = fopen(check_path.c_str(), "r");
+    if (!f) {
+      fprintf(stderr, "cannot open baseline %s\n", check_path.c_str());
+      return 2;
+    }
+    int tick;
+    unsigned long long hash;
+    while (fscanf(f, "%d %llx", &tick, &hash) == 2) {
+      baseline[tick] = hash;
+    }
+    fclose(f);
+  }
+  FILE* out = write_path.empty() ? nullptr : fopen(write_path.c_str(), "w");
+
+  H::deterministic = !timed;
+  std::unique_ptr<Strategy> strategy(new MyStrategy);
+  model::Game game;
+  RollingHash hash;
+  int ticks = 0;
+  while (std::getline(in, line)) {
+    document.Parse(line.c_str());
+    if (document.HasParseError()) {
+      break;
+    }
+    game.read(document);
+    std::unordered_map<int, model::Action> actions;
+    for (const auto& robot : game.robots) {
+      if (robot.is_teammate) {
+        strategy->act(robot, rules, game, actions[robot.id]);
+      }
+    }
+    for (const auto& robot : game.robots) {
+      if (robot.is_teammate) {
+        const auto& action = actions[robot.id];
+        hash.add(action.target_velocity_x);
+        hash.add(action.target_velocity_y);
+        hash.add(action.target_velocity_z);
+        hash.add(action.jump_speed);
+        hash.add(action.use_nitro ? 1. : 0.);
+      }
+    }
+    for (int id = 0; id < 3; ++id) {
+      hash.add(H::best_plan[id].score.score());
+    }
+    ticks++;
+    if (out) {
+      fprintf(out, "%d %016llx\n", game.current_tick, (unsigned long long) hash.value);
+    }
+    if (!check_path.empty()) {
+      const auto& it = baseline.find(game.current_tick);
+      if (it != baseline.end() && it->second != hash.value) {
+        fprintf(stderr, "first divergence at tick %d: %016llx, baseline %016llx\n",
+                game.current_tick, (unsigned long long) hash.value, (unsigned long long) it->second);
+        return 1;
+      }
+    }
+  }
+  if (out) {
+    fclose(out);
+  }
+  printf("%d ticks, hash %016llx\n", ticks, (unsigned long long) hash.value);
+  if (timed) {
+    printf("%.1f iterations per tick\n", ticks == 0 ? 0. : (double) H::search_iterations / ticks);
+  }
+  return 0;
+}
@@ -24,17 +24,17 @@ Runner::Runner(const char* host, const char* port, const char* token)
 
 void Runner::run() {
     unique_ptr<Strategy> strategy(new MyStrategy);
-    unique_ptr<Game> game;
+    Game game;
     unordered_map<int, Action> actions;
     remoteProcessClient.write_token(token);
     unique_ptr<Rules> rules = remoteProcessClient.read_rules();
-    while ((game = remoteProcessClient.read_game()) != nullptr) {
+    while (remoteProcessClient.read_game(game)) {
         actions.clear();
-        for (const Robot& robot : game->robots) {
+        for (const Robot& robot : game.robots) {
             if (robot.is_teammate) {
-                strategy->act(robot, *rules, *game, actions[robot.id]);
+                strategy->act(robot, *rules, game, actions[robot.id]);
             }
         }
-        remoteProcessClient.write(actions, strategy->custom_rendering());
+        remoteProcessClient.write(actions, *strategy);
     }
 }
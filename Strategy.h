@@ -9,11 +9,14 @@
 #include "model/Game.h"
 #include "model/Action.h"
 #include "model/Robot.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
 
 class Strategy {
 public:
     virtual void act(const model::Robot& me, const model::Rules& rules, const model::Game& game, model::Action& action) = 0;
-    virtual std::string custom_rendering() = 0;
+    // one json value (array of draw primitives) or nothing, written straight into the outgoing message
+    virtual void custom_rendering(rapidjson::Writer<rapidjson::StringBuffer>& /*writer*/) { }
 
     virtual ~Strategy();
 };
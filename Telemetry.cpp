@@ -0,0 +1,89 @@
+#ifdef LOCAL
+#include <Telemetry.h>
+#else
+#include "Telemetry.h"
+#endif
+
+#ifdef TELEMETRY
+
+#include <algorithm>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+Telemetry::Record Telemetry::records[Telemetry::CAPACITY];
+int64_t Telemetry::records_count = 0;
+char Telemetry::path[256];
+int64_t Telemetry::trigger_fires[Telemetry::TRIGGERS_COUNT];
+int64_t Telemetry::last_trigger_fires[Telemetry::TRIGGERS_COUNT];
+
+static void onSignal(int signal) {
+  Telemetry::flush();
+  std::signal(signal, SIG_DFL);
+  std::raise(signal);
+}
+
+void Telemetry::init() {
+  const char* env_path = std::getenv("TELEMETRY_FILE");
+  if (env_path && *env_path) {
+    std::strncpy(path, env_path, sizeof(path) - 1);
+    path[sizeof(path) - 1] = 0;
+  } else {
+    snprintf(path, sizeof(path), "telemetry.%d.bin", (int) getpid());
+  }
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+}
+
+Telemetry::Record& Telemetry::next() {
+  Record& record = records[records_count++ % CAPACITY];
+  std::memset(&record, 0, sizeof(record));
+  return record;
+}
+
+void Telemetry::takeTriggerFires(Record& record) {
+  for (int i = 0; i < TRIGGERS_COUNT; ++i) {
+    record.trigger_fires[i] = int32_t(trigger_fires[i] - last_trigger_fires[i]);
+    last_trigger_fires[i] = trigger_fires[i];
+  }
+}
+
+static bool writeAll(const int fd, const void* data, size_t size) {
+  const char* ptr = (const char*) data;
+  while (size > 0) {
+    const ssize_t written = write(fd, ptr, size);
+    if (written <= 0) {
+      return false;
+    }
+    ptr += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool Telemetry::flush() {
+  const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  const int64_t count = records_count < CAPACITY ? records_count : CAPACITY;
+  const int64_t first = records_count - count;
+  FileHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.record_size = sizeof(Record);
+  header.records = int32_t(count);
+  bool ok = writeAll(fd, &header, sizeof(header));
+  // oldest to newest, at most two pieces of the ring
+  const int64_t begin = first % CAPACITY;
+  const int64_t tail = std::min<int64_t>(count, CAPACITY - begin);
+  ok = ok && writeAll(fd, records + begin, tail * sizeof(Record));
+  ok = ok && writeAll(fd, records, (count - tail) * sizeof(Record));
+  close(fd);
+  return ok;
+}
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef CODEBALL_TELEMETRY_H
+#define CODEBALL_TELEMETRY_H
+
+#include <cstdint>
+
+// per decision tick records in a fixed ring buffer, written to binary file at game end or on SIGINT/SIGTERM
+// TelemetryToCsv converts the file to csv
+// recording exists only with TELEMETRY define, file layout is shared with the reader
+struct Telemetry {
+
+  enum Trigger {
+    ACCELERATION,
+    ENTITY_ENTITY,
+    ENTITY_BALL,
+    ENTITY_ARENA,
+    BALL_ARENA,
+    TRIGGERS_COUNT
+  };
+
+  struct Record {
+    int32_t tick;
+    int32_t iterations[3];
+    int32_t configuration[3]; // of the best plan
+    int32_t role[3];
+    float best_score[3];
+    float budget; // seconds, given to the tick
+    float used; // seconds, spent in doStrategy
+    float enemies_prediction; // seconds
+    float global_time; // seconds, global timer after the tick
+    int32_t trigger_fires[TRIGGERS_COUNT]; // during the tick
+  };
+
+  struct FileHeader {
+    char magic[4];
+    int32_t version;
+    int32_t record_size;
+    int32_t records;
+  };
+
+  static constexpr char MAGIC[4] = {'C', 'B', 'T', 'L'};
+  static constexpr int32_t VERSION = 1;
+
+#ifdef TELEMETRY
+  static constexpr int CAPACITY = 1 << 14; // 3x3 game has 9000 decision ticks with TPT = 2
+
+  static Record records[CAPACITY];
+  static int64_t records_count;
+  static char path[256];
+
+  // counters of SmartSimulator, never reset
+  static int64_t trigger_fires[TRIGGERS_COUNT];
+  static int64_t last_trigger_fires[TRIGGERS_COUNT];
+
+  // file name from TELEMETRY_FILE env, telemetry.<pid>.bin by default, so bots and replays in one directory don't clash
+  static void init();
+
+  // zeroed slot for the next record, the oldest one is overwritten
+  static Record& next();
+
+  static void takeTriggerFires(Record& record);
+
+  // async signal safe, only open/write/close
+  static bool flush();
+
+  static inline void fire(const Trigger& trigger) {
+    trigger_fires[trigger]++;
+  }
+#endif
+};
+
+#ifdef TELEMETRY
+#define TELEMETRY_FIRE(trigger) Telemetry::fire(Telemetry::trigger)
+#else
+#define TELEMETRY_FIRE(trigger)
+#endif
+
+#endif //CODEBALL_TELEMETRY_H
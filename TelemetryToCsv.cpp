@@ -0,0 +1,59 @@
+#include "Telemetry.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// telemetry_to_csv <telemetry.bin> [out.csv], stdout by default
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "usage: %s <telemetry.bin> [out.csv]\n", argv[0]);
+    return 1;
+  }
+  FILE* in = fopen(argv[1], "rb");
+  if (!in) {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+  Telemetry::FileHeader header;
+  if (fread(&header, sizeof(header), 1, in) != 1
+      || std::memcmp(header.magic, Telemetry::MAGIC, sizeof(Telemetry::MAGIC)) != 0
+      || header.version != Telemetry::VERSION
+      || header.record_size != (int32_t) sizeof(Telemetry::Record)) {
+    fprintf(stderr, "%s is not a telemetry file of version %d\n", argv[1], Telemetry::VERSION);
+    fclose(in);
+    return 1;
+  }
+  std::vector<Telemetry::Record> records(header.records);
+  const size_t read = fread(records.data(), sizeof(Telemetry::Record), records.size(), in);
+  fclose(in);
+  if (read != records.size()) {
+    fprintf(stderr, "truncated file, %zu of %d records\n", read, header.records);
+    records.resize(read);
+  }
+
+  FILE* out = argc > 2 ? fopen(argv[2], "w") : stdout;
+  if (!out) {
+    fprintf(stderr, "cannot open %s\n", argv[2]);
+    return 1;
+  }
+  fprintf(out, "tick,budget,used,enemies_prediction,global_time");
+  for (int id = 0; id < 3; ++id) {
+    fprintf(out, ",iterations%d,configuration%d,role%d,best_score%d", id, id, id, id);
+  }
+  fprintf(out, ",acceleration_fires,entity_entity_fires,entity_ball_fires,entity_arena_fires,ball_arena_fires\n");
+  for (const auto& r : records) {
+    fprintf(out, "%d,%.6f,%.6f,%.6f,%.3f", r.tick, r.budget, r.used, r.enemies_prediction, r.global_time);
+    for (int id = 0; id < 3; ++id) {
+      fprintf(out, ",%d,%d,%d,%g", r.iterations[id], r.configuration[id], r.role[id], r.best_score[id]);
+    }
+    for (int i = 0; i < Telemetry::TRIGGERS_COUNT; ++i) {
+      fprintf(out, ",%d", r.trigger_fires[i]);
+    }
+    fprintf(out, "\n");
+  }
+  if (out != stdout) {
+    fclose(out);
+  }
+  return 0;
+}
@@ -0,0 +1,256 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rapidjson/document.h"
+
+// round robin of bot versions on local_server, matches run in parallel, every bot process has own core
+// tournament --bot name=command --bot name=command [...] [--games 2] [--jobs N] [--team-size 3] [--ticks 18000]
+//            [--server path] [--base-port 33000] [--tick-timeout-ms 0] [--seed 1]
+// prebuilt bots of the repo (v44, only_goalkeeper, ...) need chmod +x before use
+
+struct Bot {
+  std::string name;
+  std::string command;
+};
+
+struct Match {
+  int first, second; // bot indexes, first plays as player 1
+  long long seed;
+  bool ok = false;
+  int score[2] = {0, 0};
+  int ticks = 0;
+  bool crashed[2] = {false, false};
+  int timeouts[2] = {0, 0};
+  double cpu_seconds[2] = {0, 0};
+  double latency_avg_ms[2] = {0, 0};
+  double latency_max_ms[2] = {0, 0};
+};
+
+struct Stats {
+  int games = 0;
+  int wins = 0;
+  int draws = 0;
+  int losses = 0;
+  int goals_for = 0;
+  int goals_against = 0;
+  int crashes = 0;
+  int timeouts = 0;
+  long long ticks = 0;
+  double cpu_seconds = 0;
+  double max_game_cpu_seconds = 0;
+  double latency_max_ms = 0;
+};
+
+static std::string quote(const std::string& value) {
+  std::string result = "'";
+  for (const char& c : value) {
+    if (c == '\'') {
+      result += "'\\''";
+    } else {
+      result += c;
+    }
+  }
+  return result + "'";
+}
+
+static void play(Match& match, const std::vector<Bot>& bots, const std::string& server, const int& slot,
+                 const int& base_port, const int& cores, const int& team_size, const int& ticks,
+                 const int& tick_timeout_ms) {
+  const int& port = base_port + 2 * slot;
+  const std::string& command = server
+      + " --quiet --p1 " + quote(bots[match.first].command)
+      + " --p2 " + quote(bots[match.second].command)
+      + " --p1-port " + std::to_string(port) + " --p2-port " + std::to_string(port + 1)
+      + " --p1-core " + std::to_string((2 * slot) % cores) + " --p2-core " + std::to_string((2 * slot + 1) % cores)
+      + " --team-size " + std::to_string(team_size) + " --ticks " + std::to_string(ticks) + " --seed " + std::to_string(match.seed)
+      + " --tick-timeout-ms " + std::to_string(tick_timeout_ms)
+      + " 2>/dev/null";
+  FILE* pipe = popen(command.c_str(), "r");
+  if (!pipe) {
+    return;
+  }
+  std::string output;
+  char buffer[4096];
+  while (fgets(buffer, sizeof(buffer), pipe)) {
+    output += buffer;
+  }
+  pclose(pipe);
+
+  rapidjson::Document document;
+  document.Parse(output.c_str());
+  if (document.HasParseError() || !document.IsObject() || !document.HasMember("score")) {
+    return;
+  }
+  match.ok = true;
+  match.ticks = document["ticks"].GetInt();
+  for (int i = 0; i < 2; ++i) {
+    match.score[i] = document["score"][i].GetInt();
+    match.crashed[i] = document["crashed"][i].GetBool();
+    match.timeouts[i] = document["timeouts"][i].GetInt();
+    match.cpu_seconds[i] = document["cpu_seconds"][i].GetDouble();
+    match.latency_avg_ms[i] = document["latency_avg_ms"][i].GetDouble();
+    match.latency_max_ms[i] = document["latency_max_ms"][i].GetDouble();
+  }
+}
+
+static void usage(const char* name) {
+  fprintf(stderr,
+          "usage: %s --bot name=command --bot name=command [...] [--games 2] [--jobs N] [--team-size 3] [--ticks 18000]\n"
+          "          [--server ./local_server] [--base-port 33000] [--tick-timeout-ms 0] [--seed 1]\n",
+          name);
+  exit(1);
+}
+
+int main(int argc, char* argv[]) {
+  std::vector<Bot> bots;
+  int games = 2;
+  const int cores = std::max(1, (int) sysconf(_SC_NPROCESSORS_ONLN));
+  int jobs = std::max(1, cores / 2);
+  int team_size = 3;
+  int ticks = 18000;
+  int base_port = 33000;
+  int tick_timeout_ms = 0;
+  long long seed = 1;
+  std::string server = "./local_server";
+  for (int i = 1; i < argc; ++i) {
+    const std::string& arg = argv[i];
+    auto value = [&]() {
+      if (i + 1 >= argc) {
+        usage(argv[0]);
+      }
+      return std::string(argv[++i]);
+    };
+    if (arg == "--bot") {
+      const std::string& bot = value();
+      const size_t& separator = bot.find('=');
+      if (separator == std::string::npos) {
+        usage(argv[0]);
+      }
+      bots.push_back({bot.substr(0, separator), bot.substr(separator + 1)});
+    } else if (arg == "--games") {
+      games = std::stoi(value());
+    } else if (arg == "--jobs") {
+      jobs = std::max(1, std::stoi(value()));
+    } else if (arg == "--team-size") {
+      team_size = std::stoi(value());
+    } else if (arg == "--ticks") {
+      ticks = std::stoi(value());
+    } else if (arg == "--server") {
+      server = value();
+    } else if (arg == "--base-port") {
+      base_port = std::stoi(value());
+    } else if (arg == "--tick-timeout-ms") {
+      tick_timeout_ms = std::stoi(value());
+    } else if (arg == "--seed") {
+      seed = std::stoll(value());
+    } else {
+      usage(argv[0]);
+    }
+  }
+  if (bots.size() < 2) {
+    usage(argv[0]);
+  }
+
+  // every pair plays games matches, sides are swapped every other game, both sides get the same seeds
+  std::vector<Match> matches;
+  for (int a = 0; a < (int) bots.size(); ++a) {
+    for (int b = a + 1; b < (int) bots.size(); ++b) {
+      for (int game = 0; game < games; ++game) {
+        Match match;
+        match.first = game % 2 == 0 ? a : b;
+        match.second = game % 2 == 0 ? b : a;
+        match.seed = seed + game / 2;
+        matches.push_back(match);
+      }
+    }
+  }
+
+  std::atomic<int> next_match(0);
+  std::mutex output_mutex;
+  std::vector<std::thread> workers;
+  for (int slot = 0; slot < jobs; ++slot) {
+    workers.emplace_back([&, slot]() {
+      while (true) {
+        const int& index = next_match++;
+        if (index >= (int) matches.size()) {
+          return;
+        }
+        auto& match = matches[index];
+        play(match, bots, server, slot, base_port, cores, team_size, ticks, tick_timeout_ms);
+        std::lock_guard<std::mutex> lock(output_mutex);
+        if (match.ok) {
+          fprintf(stderr, "%s %d:%d %s seed %lld, cpu %.1fs / %.1fs\n",
+                  bots[match.first].name.c_str(), match.score[0], match.score[1], bots[match.second].name.c_str(),
+                  match.seed, match.cpu_seconds[0], match.cpu_seconds[1]);
+        } else {
+          fprintf(stderr, "%s vs %s seed %lld failed\n",
+                  bots[match.first].name.c_str(), bots[match.second].name.c_str(), match.seed);
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  std::vector<Stats> stats(bots.size());
+  std::map<std::pair<int, int>, std::pair<int, int>> head_to_head; // wins of first, wins of second
+  for (const auto& match : matches) {
+    if (!match.ok) {
+      continue;
+    }
+    const int sides[2] = {match.first, match.second};
+    for (int i = 0; i < 2; ++i) {
+      auto& s = stats[sides[i]];
+      const int& mine = match.score[i];
+      const int& theirs = match.score[1 - i];
+      s.games++;
+      s.wins += mine > theirs;
+      s.draws += mine == theirs;
+      s.losses += mine < theirs;
+      s.goals_for += mine;
+      s.goals_against += theirs;
+      s.crashes += match.crashed[i];
+      s.timeouts += match.timeouts[i];
+      s.ticks += match.ticks;
+      s.cpu_seconds += match.cpu_seconds[i];
+      s.max_game_cpu_seconds = std::max(s.max_game_cpu_seconds, match.cpu_seconds[i]);
+      s.latency_max_ms = std::max(s.latency_max_ms, match.latency_max_ms[i]);
+    }
+    const int& a = std::min(match.first, match.second);
+    const int& b = std::max(match.first, match.second);
+    const int& score_a = match.first == a ? match.score[0] : match.score[1];
+    const int& score_b = match.first == a ? match.score[1] : match.score[0];
+    head_to_head[{a, b}].first += score_a > score_b;
+    head_to_head[{a, b}].second += score_b > score_a;
+  }
+
+  printf("%-20s %6s %5s %5s %5s %7s %9s %9s %9s %10s %10s %8s %8s\n",
+         "bot", "games", "win", "draw", "loss", "win,%", "goals", "cpu,s", "max cpu,s", "ms/tick", "max lat,ms",
+         "timeouts", "crashes");
+  for (int i = 0; i < (int) bots.size(); ++i) {
+    const auto& s = stats[i];
+    printf("%-20s %6d %5d %5d %5d %7.1f %4d:%-4d %9.1f %9.1f %10.3f %10.1f %8d %8d\n",
+           bots[i].name.c_str(), s.games, s.wins, s.draws, s.losses,
+           s.games == 0 ? 0. : 100. * (s.wins + 0.5 * s.draws) / s.games,
+           s.goals_for, s.goals_against,
+           s.games == 0 ? 0. : s.cpu_seconds / s.games, s.max_game_cpu_seconds,
+           s.ticks == 0 ? 0. : 1000 * s.cpu_seconds / s.ticks, s.latency_max_ms,
+           s.timeouts, s.crashes);
+  }
+  printf("\n");
+  for (const auto& it : head_to_head) {
+    printf("%s - %s: %d - %d\n", bots[it.first.first].name.c_str(), bots[it.first.second].name.c_str(),
+           it.second.first, it.second.second);
+  }
+  return 0;
+}
@@ -24,15 +24,20 @@ namespace model {
             this->use_nitro = false;
         }
 
-        rapidjson::Value to_json(rapidjson::Document::AllocatorType& allocator) const {
-            rapidjson::Value json;
-            json.SetObject();
-            json.AddMember("target_velocity_x", target_velocity_x, allocator);
-            json.AddMember("target_velocity_y", target_velocity_y, allocator);
-            json.AddMember("target_velocity_z", target_velocity_z, allocator);
-            json.AddMember("jump_speed", jump_speed, allocator);
-            json.AddMember("use_nitro", use_nitro, allocator);
-            return json;
+        template<typename Writer>
+        void write(Writer& writer) const {
+            writer.StartObject();
+            writer.Key("target_velocity_x");
+            writer.Double(target_velocity_x);
+            writer.Key("target_velocity_y");
+            writer.Double(target_velocity_y);
+            writer.Key("target_velocity_z");
+            writer.Double(target_velocity_z);
+            writer.Key("jump_speed");
+            writer.Double(jump_speed);
+            writer.Key("use_nitro");
+            writer.Bool(use_nitro);
+            writer.EndObject();
         }
     };
 }
@@ -0,0 +1,471 @@
+#ifdef LOCAL
+#include <model/ArenaGeometry.h>
+#else
+#include "ArenaGeometry.h"
+#endif
+
+#include <algorithm>
+#include <math.h>
+
+ArenaGeometry::Primitive ArenaGeometry::primitives[ArenaGeometry::MAX_PRIMITIVES];
+int ArenaGeometry::primitives_size = 0;
+double ArenaGeometry::max_radius;
+double ArenaGeometry::hole_x;
+double ArenaGeometry::hole_y;
+double ArenaGeometry::hole_r;
+Point2d ArenaGeometry::hole_o;
+double ArenaGeometry::breaks[3][ArenaGeometry::MAX_BREAKS];
+int ArenaGeometry::breaks_size[3];
+double ArenaGeometry::origin[3];
+std::vector<int> ArenaGeometry::slot_interval[3];
+std::vector<int> ArenaGeometry::cell_begin;
+std::vector<unsigned char> ArenaGeometry::cell_primitives;
+std::vector<bool> ArenaGeometry::cell_ground_only;
+ArenaGeometry::Grid ArenaGeometry::grids[ArenaGeometry::MAX_GRIDS];
+int ArenaGeometry::grids_size = 0;
+
+ArenaGeometry::Primitive& ArenaGeometry::add(const Kind& kind, const int& surface_id, const double& radius) {
+  Primitive& p = primitives[primitives_size++];
+  p = Primitive();
+  p.kind = kind;
+  p.surface_id = surface_id;
+  p.radius = radius;
+  for (int axis = 0; axis < 3; ++axis) {
+    p.lo[axis] = -INF;
+    p.hi[axis] = INF;
+    p.center_lo[axis] = -INF;
+    p.center_hi[axis] = INF;
+  }
+  p.goal_hole = false;
+  p.ring_side = 0;
+  return p;
+}
+
+void ArenaGeometry::addBreak(const int& axis, const double& value) {
+  if (value <= origin[axis] || breaks_size[axis] == MAX_BREAKS) {
+    return;
+  }
+  for (int i = 0; i < breaks_size[axis]; ++i) {
+    if (fabs(breaks[axis][i] - value) < 1e-9) {
+      return;
+    }
+  }
+  breaks[axis][breaks_size[axis]++] = value;
+}
+
+static inline double sq(const double& value) {
+  return value * value;
+}
+
+// max and min over [lo, hi] of distance from value to segment [a, b]
+static inline double maxOutside(const double& lo, const double& hi, const double& a, const double& b) {
+  return std::max(0., std::max(a - lo, hi - b));
+}
+
+static inline double minOutside(const double& lo, const double& hi, const double& a, const double& b) {
+  return std::max(0., std::max(a - hi, lo - b));
+}
+
+// true when surface of p can be closer than radius to some point of the box
+bool ArenaGeometry::mayTouch(const Primitive& p, const double* lo, const double* hi, const double& radius) {
+  for (int axis = 0; axis < 3; ++axis) {
+    if (hi[axis] <= p.lo[axis] || lo[axis] >= p.hi[axis]) {
+      return false;
+    }
+  }
+  if (p.kind == PLANE) {
+    if (p.goal_hole && hi[0] <= hole_x && hi[1] <= hole_y
+        && (hi[0] <= hole_o.x || hi[1] <= hole_o.y)) {
+      return false;
+    }
+    double min_distance = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+      const double& n = p.plane_normal[axis];
+      min_distance += n * ((n > 0 ? lo[axis] : hi[axis]) - p.plane_point[axis]);
+    }
+    return min_distance < radius;
+  }
+  if (p.kind == SPHERE_INNER || p.kind == SPHERE_OUTER) {
+    double max_sq = 0, min_sq = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+      max_sq += sq(maxOutside(lo[axis], hi[axis], p.center_lo[axis], p.center_hi[axis]));
+      min_sq += sq(minOutside(lo[axis], hi[axis], p.center_lo[axis], p.center_hi[axis]));
+    }
+    if (p.kind == SPHERE_INNER) {
+      return p.radius < radius || max_sq > sq(p.radius - radius);
+    }
+    return min_sq < sq(p.radius + radius);
+  }
+
+  double ring_min_sq = 0, ring_max_sq = 0;
+  const int axes[2] = {p.ring_a, p.ring_b};
+  for (int i = 0; i < 2; ++i) {
+    const int& axis = axes[i];
+    ring_min_sq += sq(minOutside(lo[axis], hi[axis], p.ring_o[i], p.ring_o[i]));
+    ring_max_sq += sq(maxOutside(lo[axis], hi[axis], p.ring_o[i], p.ring_o[i]));
+  }
+  const double& ring_min = sqrt(ring_min_sq);
+  const double& ring_max = sqrt(ring_max_sq);
+  if ((p.ring_side > 0 && ring_max <= p.ring_radius) || (p.ring_side < 0 && ring_min >= p.ring_radius)) {
+    return false;
+  }
+  double tube_max_sq = std::max(sq(ring_min - p.ring_radius), sq(ring_max - p.ring_radius));
+  double tube_min_sq = p.ring_radius > ring_min && p.ring_radius < ring_max
+                       ? 0 : std::min(sq(ring_min - p.ring_radius), sq(ring_max - p.ring_radius));
+  tube_max_sq += sq(maxOutside(lo[p.ring_k], hi[p.ring_k], p.ring_k_value, p.ring_k_value));
+  tube_min_sq += sq(minOutside(lo[p.ring_k], hi[p.ring_k], p.ring_k_value, p.ring_k_value));
+  if (p.kind == TORUS_INNER) {
+    return p.radius < radius || tube_max_sq > sq(p.radius - radius);
+  }
+  return tube_min_sq < sq(p.radius + radius);
+}
+
+void ArenaGeometry::buildGrid(Grid& grid, const double& radius) {
+  grid.radius = radius;
+  int cells = 1;
+  for (int axis = 0; axis < 3; ++axis) {
+    grid.size[axis] = (int) ceil(slot_interval[axis].size() / (double) SLOTS_PER_UNIT / GRID_STEP);
+    cells *= grid.size[axis];
+  }
+  grid.begin.assign(cells + 1, 0);
+  grid.primitives.clear();
+  grid.cell_class.assign(cells, EMPTY);
+  double lo[3], hi[3];
+  for (int ix = 0; ix < grid.size[0]; ++ix) {
+    lo[0] = origin[0] + ix * GRID_STEP;
+    hi[0] = lo[0] + GRID_STEP;
+    for (int iy = 0; iy < grid.size[1]; ++iy) {
+      lo[1] = origin[1] + iy * GRID_STEP;
+      hi[1] = lo[1] + GRID_STEP;
+      for (int iz = 0; iz < grid.size[2]; ++iz) {
+        lo[2] = origin[2] + iz * GRID_STEP;
+        hi[2] = lo[2] + GRID_STEP;
+        const int& cell_id = (ix * grid.size[1] + iy) * grid.size[2] + iz;
+        grid.begin[cell_id] = (int) grid.primitives.size();
+        for (int i = 0; i < primitives_size; ++i) {
+          if (mayTouch(primitives[i], lo, hi, radius)) {
+            grid.primitives.push_back((unsigned char) i);
+            if (primitives[i].surface_id == 1 && grid.cell_class[cell_id] == EMPTY) {
+              grid.cell_class[cell_id] = FLOOR_ONLY;
+            } else {
+              grid.cell_class[cell_id] = CANDIDATES;
+            }
+          }
+        }
+      }
+    }
+  }
+  grid.begin[cells] = (int) grid.primitives.size();
+}
+
+void ArenaGeometry::build(const model::Arena& arena, const std::vector<double>& radiuses) {
+  max_radius = *std::max_element(radiuses.begin(), radiuses.end());
+  primitives_size = 0;
+
+  const double& w = arena.width / 2;
+  const double& h = arena.height;
+  const double& d = arena.depth / 2;
+  const double& br = arena.bottom_radius;
+  const double& tr = arena.top_radius;
+  const double& cr = arena.corner_radius;
+  const double& gw = arena.goal_width / 2;
+  const double& gh = arena.goal_height;
+  const double& gd = arena.goal_depth;
+  const double& gtr = arena.goal_top_radius;
+  const double& gsr = arena.goal_side_radius;
+
+  hole_x = gw + gsr;
+  hole_y = gh + gsr;
+  hole_o = {gw - gtr, gh - gtr};
+  hole_r = gtr + gsr;
+
+  // surface ids are the same as in the old hand written dan_to_arena_quarter
+  {
+    // Ground
+    auto& p = add(PLANE, 1, 0);
+    p.plane_point[0] = 0, p.plane_point[1] = 0, p.plane_point[2] = 0;
+    p.plane_normal[0] = 0, p.plane_normal[1] = 1, p.plane_normal[2] = 0;
+  }
+  {
+    // Ceiling
+    auto& p = add(PLANE, 15, 0);
+    p.plane_point[0] = 0, p.plane_point[1] = h, p.plane_point[2] = 0;
+    p.plane_normal[0] = 0, p.plane_normal[1] = -1, p.plane_normal[2] = 0;
+  }
+  {
+    // Side x
+    auto& p = add(PLANE, 2, 0);
+    p.plane_point[0] = w, p.plane_point[1] = 0, p.plane_point[2] = 0;
+    p.plane_normal[0] = -1, p.plane_normal[1] = 0, p.plane_normal[2] = 0;
+  }
+  {
+    // Side z (goal)
+    auto& p = add(PLANE, 21, 0);
+    p.plane_point[0] = 0, p.plane_point[1] = 0, p.plane_point[2] = d + gd;
+    p.plane_normal[0] = 0, p.plane_normal[1] = 0, p.plane_normal[2] = -1;
+  }
+  {
+    // Side z
+    auto& p = add(PLANE, 12, 0);
+    p.plane_point[0] = 0, p.plane_point[1] = 0, p.plane_point[2] = d;
+    p.plane_normal[0] = 0, p.plane_normal[1] = 0, p.plane_normal[2] = -1;
+    p.goal_hole = true;
+  }
+  {
+    // Side x (goal)
+    auto& p = add(PLANE, 9, 0);
+    p.lo[2] = d + gsr;
+    p.plane_point[0] = gw, p.plane_point[1] = 0, p.plane_point[2] = 0;
+    p.plane_normal[0] = -1, p.plane_normal[1] = 0, p.plane_normal[2] = 0;
+  }
+  {
+    // Ceiling (goal)
+    auto& p = add(PLANE, 14, 0);
+    p.lo[2] = d + gsr;
+    p.plane_point[0] = 0, p.plane_point[1] = gh, p.plane_point[2] = 0;
+    p.plane_normal[0] = 0, p.plane_normal[1] = -1, p.plane_normal[2] = 0;
+  }
+  {
+    // Goal back corners
+    auto& p = add(SPHERE_INNER, 3, br);
+    p.lo[2] = d + gd - br;
+    p.center_lo[0] = br - gw, p.center_hi[0] = gw - br;
+    p.center_lo[1] = br, p.center_hi[1] = gh - gtr;
+    p.center_lo[2] = p.center_hi[2] = d + gd - br;
+  }
+  {
+    // Corner
+    auto& p = add(SPHERE_INNER, 5, cr);
+    p.lo[0] = w - cr;
+    p.lo[2] = d - cr;
+    p.center_lo[0] = p.center_hi[0] = w - cr;
+    p.center_lo[2] = p.center_hi[2] = d - cr;
+  }
+  {
+    // Goal outer corner, side x
+    auto& p = add(SPHERE_OUTER, 13, gsr);
+    p.hi[0] = gw + gsr;
+    p.hi[2] = d + gsr;
+    p.center_lo[0] = p.center_hi[0] = gw + gsr;
+    p.center_lo[2] = p.center_hi[2] = d + gsr;
+  }
+  {
+    // Goal outer corner, ceiling
+    auto& p = add(SPHERE_OUTER, 18, gsr);
+    p.hi[1] = gh + gsr;
+    p.hi[2] = d + gsr;
+    p.center_lo[1] = p.center_hi[1] = gh + gsr;
+    p.center_lo[2] = p.center_hi[2] = d + gsr;
+  }
+  {
+    // Goal outer corner, top corner
+    auto& p = add(TORUS_OUTER, 19, gsr);
+    p.lo[0] = gw - gtr;
+    p.lo[1] = gh - gtr;
+    p.hi[2] = d + gsr;
+    p.ring_a = 0, p.ring_b = 1, p.ring_k = 2;
+    p.ring_o[0] = gw - gtr, p.ring_o[1] = gh - gtr;
+    p.ring_radius = gtr + gsr;
+    p.ring_k_value = d + gsr;
+  }
+  {
+    // Goal inside top corners, side x
+    auto& p = add(SPHERE_INNER, 11, gtr);
+    p.lo[0] = gw - gtr;
+    p.lo[1] = gh - gtr;
+    p.lo[2] = d + gsr;
+    p.center_lo[0] = p.center_hi[0] = gw - gtr;
+    p.center_lo[1] = p.center_hi[1] = gh - gtr;
+  }
+  {
+    // Goal inside top corners, side z
+    auto& p = add(SPHERE_INNER, 22, gtr);
+    p.lo[1] = gh - gtr;
+    p.lo[2] = std::max(d + gsr, d + gd - gtr);
+    p.center_lo[1] = p.center_hi[1] = gh - gtr;
+    p.center_lo[2] = p.center_hi[2] = d + gd - gtr;
+  }
+  {
+    // Bottom corners, side x
+    auto& p = add(SPHERE_INNER, 4, br);
+    p.hi[1] = br;
+    p.lo[0] = w - br;
+    p.center_lo[0] = p.center_hi[0] = w - br;
+    p.center_lo[1] = p.center_hi[1] = br;
+  }
+  {
+    // Bottom corners, side z
+    auto& p = add(SPHERE_INNER, 10, br);
+    p.hi[1] = br;
+    p.lo[0] = gw + gsr;
+    p.lo[2] = d - br;
+    p.center_lo[1] = p.center_hi[1] = br;
+    p.center_lo[2] = p.center_hi[2] = d - br;
+  }
+  {
+    // Bottom corners, side z (goal)
+    auto& p = add(SPHERE_INNER, 20, br);
+    p.hi[1] = br;
+    p.lo[2] = d + gd - br;
+    p.center_lo[1] = p.center_hi[1] = br;
+    p.center_lo[2] = p.center_hi[2] = d + gd - br;
+  }
+  {
+    // Bottom corners, goal outer corner
+    auto& p = add(TORUS_INNER, 8, br);
+    p.hi[0] = gw + gsr;
+    p.hi[1] = br;
+    p.hi[2] = d + gsr;
+    p.ring_a = 0, p.ring_b = 2, p.ring_k = 1;
+    p.ring_o[0] = gw + gsr, p.ring_o[1] = d + gsr;
+    p.ring_radius = gsr + br;
+    p.ring_k_value = br;
+    p.ring_side = -1;
+  }
+  {
+    // Bottom corners, side x (goal)
+    auto& p = add(SPHERE_INNER, 6, br);
+    p.hi[1] = br;
+    p.lo[0] = gw - br;
+    p.lo[2] = d + gsr;
+    p.center_lo[0] = p.center_hi[0] = gw - br;
+    p.center_lo[1] = p.center_hi[1] = br;
+  }
+  {
+    // Bottom corners, corner
+    auto& p = add(TORUS_INNER, 7, br);
+    p.hi[1] = br;
+    p.lo[0] = w - cr;
+    p.lo[2] = d - cr;
+    p.ring_a = 0, p.ring_b = 2, p.ring_k = 1;
+    p.ring_o[0] = w - cr, p.ring_o[1] = d - cr;
+    p.ring_radius = cr - br;
+    p.ring_k_value = br;
+    p.ring_side = 1;
+  }
+  {
+    // Ceiling corners, side x
+    auto& p = add(SPHERE_INNER, 12, tr);
+    p.lo[1] = h - tr;
+    p.lo[0] = w - tr;
+    p.center_lo[0] = p.center_hi[0] = w - tr;
+    p.center_lo[1] = p.center_hi[1] = h - tr;
+  }
+  {
+    // Ceiling corners, side z
+    auto& p = add(SPHERE_INNER, 16, tr);
+    p.lo[1] = h - tr;
+    p.lo[2] = d - tr;
+    p.center_lo[1] = p.center_hi[1] = h - tr;
+    p.center_lo[2] = p.center_hi[2] = d - tr;
+  }
+  {
+    // Ceiling corners, corner
+    auto& p = add(TORUS_INNER, 17, tr);
+    p.lo[1] = h - tr;
+    p.lo[0] = w - cr;
+    p.lo[2] = d - cr;
+    p.ring_a = 0, p.ring_b = 2, p.ring_k = 1;
+    p.ring_o[0] = w - cr, p.ring_o[1] = d - cr;
+    p.ring_radius = cr - tr;
+    p.ring_k_value = h - tr;
+    p.ring_side = 1;
+  }
+
+  origin[0] = 0;
+  origin[1] = -max_radius;
+  origin[2] = 0;
+  const double extent[3] = {w + max_radius, h + 2 * max_radius, d + gd + max_radius};
+  for (int axis = 0; axis < 3; ++axis) {
+    breaks_size[axis] = 0;
+  }
+
+  for (int i = 0; i < primitives_size; ++i) {
+    const auto& p = primitives[i];
+    for (int axis = 0; axis < 3; ++axis) {
+      if (p.lo[axis] > -INF) {
+        addBreak(axis, p.lo[axis]);
+      }
+      if (p.hi[axis] < INF) {
+        addBreak(axis, p.hi[axis]);
+      }
+    }
+    if (p.kind == PLANE) {
+      for (int axis = 0; axis < 3; ++axis) {
+        if (p.plane_normal[axis] != 0) {
+          addBreak(axis, p.plane_point[axis] + p.plane_normal[axis] * max_radius);
+        }
+      }
+    } else if (p.kind == SPHERE_INNER || p.kind == SPHERE_OUTER) {
+      for (int axis = 0; axis < 3; ++axis) {
+        if (p.center_lo[axis] == p.center_hi[axis]) {
+          const double& gap = p.kind == SPHERE_INNER ? p.radius - max_radius : p.radius + max_radius;
+          addBreak(axis, p.center_lo[axis] - gap);
+          addBreak(axis, p.center_lo[axis] + gap);
+        }
+      }
+    } else {
+      const double& gap = p.kind == TORUS_INNER ? p.radius - max_radius : p.radius + max_radius;
+      addBreak(p.ring_k, p.ring_k_value - gap);
+      addBreak(p.ring_k, p.ring_k_value + gap);
+    }
+  }
+  addBreak(0, hole_x);
+  addBreak(1, hole_y);
+  addBreak(0, hole_o.x);
+  addBreak(1, hole_o.y);
+
+  for (int axis = 0; axis < 3; ++axis) {
+    std::sort(breaks[axis], breaks[axis] + breaks_size[axis]);
+    const int& slots = int(extent[axis] * SLOTS_PER_UNIT) + 1;
+    slot_interval[axis].assign(slots, 0);
+    int cur = 0;
+    for (int slot = 0; slot < slots; ++slot) {
+      const double& value = origin[axis] + (double) slot / SLOTS_PER_UNIT;
+      while (cur < breaks_size[axis] && value >= breaks[axis][cur]) {
+        cur++;
+      }
+      slot_interval[axis][slot] = cur;
+    }
+  }
+
+  const int& cells = (breaks_size[0] + 1) * (breaks_size[1] + 1) * (breaks_size[2] + 1);
+  cell_begin.assign(cells + 1, 0);
+  cell_primitives.clear();
+  cell_ground_only.assign(cells, false);
+  double lo[3], hi[3];
+  for (int ix = 0; ix <= breaks_size[0]; ++ix) {
+    lo[0] = ix == 0 ? -INF : breaks[0][ix - 1];
+    hi[0] = ix == breaks_size[0] ? INF : breaks[0][ix];
+    for (int iy = 0; iy <= breaks_size[1]; ++iy) {
+      lo[1] = iy == 0 ? -INF : breaks[1][iy - 1];
+      hi[1] = iy == breaks_size[1] ? INF : breaks[1][iy];
+      for (int iz = 0; iz <= breaks_size[2]; ++iz) {
+        lo[2] = iz == 0 ? -INF : breaks[2][iz - 1];
+        hi[2] = iz == breaks_size[2] ? INF : breaks[2][iz];
+        const int& cell = cellIndex(ix, iy, iz);
+        cell_begin[cell] = (int) cell_primitives.size();
+        bool ground_only = true;
+        for (int i = 0; i < primitives_size; ++i) {
+          if (mayTouch(primitives[i], lo, hi, max_radius)) {
+            cell_primitives.push_back((unsigned char) i);
+            if (primitives[i].surface_id != 1) {
+              ground_only = false;
+            }
+          }
+        }
+        cell_ground_only[cell] = ground_only;
+      }
+    }
+  }
+  cell_begin[cells] = (int) cell_primitives.size();
+
+  std::vector<double> sorted_radiuses = radiuses;
+  std::sort(sorted_radiuses.begin(), sorted_radiuses.end());
+  grids_size = 0;
+  for (const auto& radius : sorted_radiuses) {
+    if (grids_size < MAX_GRIDS && (grids_size == 0 || grids[grids_size - 1].radius < radius)) {
+      buildGrid(grids[grids_size++], radius);
+    }
+  }
+}
@@ -0,0 +1,200 @@
+#ifndef CODEBALL_ARENAGEOMETRY_H
+#define CODEBALL_ARENAGEOMETRY_H
+
+#ifdef LOCAL
+#include <model/Arena.h>
+#include <model/Point2d.h>
+#else
+#include "Arena.h"
+#include "Point2d.h"
+#endif
+
+#include <vector>
+
+// arena surfaces compiled from rules once at tick 0
+// quarter space (x >= 0, z >= 0) is cut into boxes by breakpoints,
+// every box keeps only primitives which can be closer than max_radius to some point inside it
+// on top of that, uniform grids for every entity radius keep even shorter candidate lists
+struct ArenaGeometry {
+
+  enum Kind {
+    PLANE,
+    SPHERE_INNER,
+    SPHERE_OUTER,
+    TORUS_INNER,
+    TORUS_OUTER
+  };
+
+  enum CellClass : unsigned char {
+    EMPTY, // cannot touch any surface
+    FLOOR_ONLY,
+    CANDIDATES
+  };
+
+  struct Primitive {
+    Kind kind;
+    int surface_id;
+    double radius;
+
+    double lo[3], hi[3]; // active only inside this box
+
+    // plane
+    double plane_point[3];
+    double plane_normal[3];
+    bool goal_hole; // plane is cut by goal mouth
+
+    // sphere center = clamp(point, center_lo, center_hi)
+    double center_lo[3], center_hi[3];
+
+    // torus tube center circle lies in plane (ring_a, ring_b) at ring_k axis = ring_k_value
+    int ring_a, ring_b, ring_k;
+    double ring_o[2];
+    double ring_radius;
+    double ring_k_value;
+    int ring_side; // 1 - only outside ring, -1 - only inside ring, 0 - any
+  };
+
+  struct Grid {
+    double radius;
+    int size[3];
+    std::vector<int> begin;
+    std::vector<unsigned char> primitives;
+    std::vector<CellClass> cell_class;
+  };
+
+  static constexpr int MAX_PRIMITIVES = 32;
+  static constexpr int MAX_BREAKS = 64;
+  static constexpr int SLOTS_PER_UNIT = 8;
+  static constexpr int MAX_GRIDS = 4;
+  static constexpr double GRID_STEP = 1.;
+  static constexpr double INF = 1e9;
+
+  static Primitive primitives[MAX_PRIMITIVES];
+  static int primitives_size;
+
+  static double max_radius;
+
+  // goal mouth in (x, y), side z plane is absent inside it
+  static double hole_x, hole_y, hole_r;
+  static Point2d hole_o;
+
+  static double breaks[3][MAX_BREAKS];
+  static int breaks_size[3];
+  static double origin[3];
+  static std::vector<int> slot_interval[3];
+
+  static std::vector<int> cell_begin;
+  static std::vector<unsigned char> cell_primitives;
+  static std::vector<bool> cell_ground_only;
+
+  static Grid grids[MAX_GRIDS]; // sorted by radius
+  static int grids_size;
+
+  // radiuses - every entity radius class, the largest one is used for breakpoint boxes
+  static void build(const model::Arena& arena, const std::vector<double>& radiuses);
+
+  static inline int interval(const int& axis, const double& value) {
+    int slot = int((value - origin[axis]) * SLOTS_PER_UNIT);
+    if (slot < 0) {
+      slot = 0;
+    } else if (slot >= (int) slot_interval[axis].size()) {
+      slot = (int) slot_interval[axis].size() - 1;
+    }
+    int result = slot_interval[axis][slot];
+    while (result < breaks_size[axis] && value >= breaks[axis][result]) {
+      result++;
+    }
+    return result;
+  }
+
+  static inline int cellIndex(const int& ix, const int& iy, const int& iz) {
+    return (ix * (breaks_size[1] + 1) + iy) * (breaks_size[2] + 1) + iz;
+  }
+
+  // point in quarter coordinates
+  static inline int cell(const double& x, const double& y, const double& z) {
+    return cellIndex(interval(0, x), interval(1, y), interval(2, z));
+  }
+
+  static inline bool insideHole(const double& x, const double& y) {
+    if (x >= hole_x || y >= hole_y) {
+      return false;
+    }
+    const Point2d& v = Point2d{x, y} - hole_o;
+    return !(v.x > 0 && v.y > 0 && v.length_sq() >= hole_r * hole_r);
+  }
+
+  // only ground can touch entity of radius <= max_radius anywhere in the box around point
+  static inline bool groundOnly(const double& x, const double& y, const double& z, const double& reach) {
+    const double& ax = x > 0 ? x : -x;
+    const double& az = z > 0 ? z : -z;
+    const int& ix_from = interval(0, ax - reach);
+    const int& ix_to = interval(0, ax + reach);
+    const int& iy_from = interval(1, y - reach);
+    const int& iy_to = interval(1, y + reach);
+    const int& iz_from = interval(2, az - reach);
+    const int& iz_to = interval(2, az + reach);
+    for (int ix = ix_from; ix <= ix_to; ++ix) {
+      for (int iy = iy_from; iy <= iy_to; ++iy) {
+        for (int iz = iz_from; iz <= iz_to; ++iz) {
+          if (!cell_ground_only[cellIndex(ix, iy, iz)]) {
+            return false;
+          }
+        }
+      }
+    }
+    return true;
+  }
+
+  static inline int gridCell(const Grid& grid, const double& x, const double& y, const double& z) {
+    const int& ix = int((x - origin[0]) * (1. / GRID_STEP));
+    const int& iy = int((y - origin[1]) * (1. / GRID_STEP));
+    const int& iz = int((z - origin[2]) * (1. / GRID_STEP));
+    if (ix < 0 || iy < 0 || iz < 0 || ix >= grid.size[0] || iy >= grid.size[1] || iz >= grid.size[2]) {
+      return -1;
+    }
+    return (ix * grid.size[1] + iy) * grid.size[2] + iz;
+  }
+
+  static inline int gridFor(const double& radius) {
+    for (int i = 0; i < grids_size; ++i) {
+      if (radius <= grids[i].radius) {
+        return i;
+      }
+    }
+    return -1;
+  }
+
+  // point in quarter coordinates
+  static inline const unsigned char* candidates(const double& x, const double& y, const double& z, const double& radius, int& count) {
+    const int& grid_id = gridFor(radius);
+    if (grid_id >= 0) {
+      const Grid& grid = grids[grid_id];
+      const int& cell_id = gridCell(grid, x, y, z);
+      if (cell_id >= 0) {
+        count = grid.begin[cell_id + 1] - grid.begin[cell_id];
+        return grid.primitives.data() + grid.begin[cell_id];
+      }
+    }
+    const int& cell_id = cell(x, y, z);
+    count = cell_begin[cell_id + 1] - cell_begin[cell_id];
+    return cell_primitives.data() + cell_begin[cell_id];
+  }
+
+  static inline CellClass classify(const double& x, const double& y, const double& z, const double& radius) {
+    const int& grid_id = gridFor(radius);
+    if (grid_id < 0) {
+      return CANDIDATES;
+    }
+    const Grid& grid = grids[grid_id];
+    const int& cell_id = gridCell(grid, x > 0 ? x : -x, y, z > 0 ? z : -z);
+    return cell_id >= 0 ? grid.cell_class[cell_id] : CANDIDATES;
+  }
+
+  static Primitive& add(const Kind& kind, const int& surface_id, const double& radius);
+  static void addBreak(const int& axis, const double& value);
+  static bool mayTouch(const Primitive& p, const double* lo, const double* hi, const double& radius);
+  static void buildGrid(Grid& grid, const double& radius);
+};
+
+#endif //CODEBALL_ARENAGEOMETRY_H
@@ -7,13 +7,4 @@
 model::Rules C::rules;
 std::mt19937_64 C::rd;
 int C::unique_plan_id = 1;
-
-#ifndef LOCAL
-namespace Frozen {
-
-model::Rules C::rules;
-std::mt19937_64 C::rd;
-int C::unique_plan_id = 1;
-
-}
-#endif
\ No newline at end of file
+int C::unique_world_id = 1;
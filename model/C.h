@@ -43,6 +43,7 @@ struct DGState {
 struct C {
 
   static int unique_plan_id;
+  static int unique_world_id;
   static model::Rules rules;
   static constexpr int TPT = 2;
   static constexpr int MAX_SIMULATION_DEPTH = 100 / TPT;
@@ -53,6 +54,23 @@ struct C {
   static constexpr int ENEMY_LIVE_TICKS = 30 / TPT;
   static constexpr double NITRO_TOUCH_EPSILON = 1.01;
   static constexpr int LONGEST_JUMP = 50 / TPT;
+  static constexpr int TREE_BRANCHING = 4; // second segments per shared first segment, TREE_SEARCH only
+  static constexpr double TREE_SEARCH_SHARE = 0.5; // search steps which go to the tree, ~ 20-23 draws of randomPlan (0.9 * 4 / 7)
+  static constexpr double JUMP_SWEEP_SHARE = 0.1; // search steps which sweep jump times, JUMP_SWEEP only
+  static constexpr int SCREENING_CANDIDATES = 16; // coarse evaluations per screening step, SCREENING only
+  static constexpr int SCREENING_TOP_K = 3; // full fidelity evaluations per screening step
+  static constexpr int JOINT_ROUNDS = 3; // search rounds over teammates per tick, JOINT_PLANNING only
+  static constexpr int EVAL_CACHE_SIZE = 1 << 12; // entries of evaluation cache, power of two, EVAL_CACHE only
+  static constexpr double EVAL_CACHE_VELOCITY_STEP = 0.01; // quantization of plan target velocities in cache key
+  static constexpr double EVAL_CACHE_JUMP_STEP = 0.01; // quantization of plan jump speed in cache key
+  static constexpr int OPPONENT_MODEL_HORIZON = 30; // ticks a prediction of enemy target is checked, OPPONENT_MODEL only
+  static constexpr double OPPONENT_MODEL_RATE = 0.02; // weight of the newest observation in enemy statistics
+  static constexpr int OPPONENT_MODEL_MIN_SAMPLES = 50; // observations before statistics are trusted
+  static constexpr double FIDELITY_MONITOR_RATE = 0.05; // weight of the newest prediction error, ADAPTIVE_FIDELITY only
+  static constexpr int FIDELITY_MIN_SAMPLES = 50; // checked predictions with possible contact before level changes
+  static constexpr double FIDELITY_TOLERANCE = 0.01; // position error over the best level still taken as equal
+  static constexpr double SPECULATION_POSITION_EPS = 0.05;
+  static constexpr double SPECULATION_VELOCITY_EPS = 0.5;
 
 #ifdef LOCAL
   static constexpr double time_limit = 320. * 1.5;
@@ -75,46 +93,4 @@ struct C {
 
 };
 
-
-
-#ifndef LOCAL
-namespace Frozen {
-
-struct DGState {
-  int x, y, z, t;
-};
-
-struct C {
-
-  static int unique_plan_id;
-  static model::Rules rules;
-  static constexpr int TPT = 1;
-  static constexpr int MAX_SIMULATION_DEPTH = 100 / TPT;
-  static constexpr int ENEMY_SIMULATION_DEPTH = 50 / TPT;
-  static constexpr int MICROTICKS_PER_TICK = 100 * TPT;
-  static constexpr double ball_antiflap = 0.1; // todo check
-  static constexpr double MIN_WALL_JUMP = 15.;
-  static constexpr int NEVER = 1000000000;
-
-#ifdef LOCAL
-  static constexpr double time_limit = 330. * 1.5;
-#else
-  static constexpr double time_limit = 330.;
-#endif
-
-  static std::mt19937_64 rd;
-
-  static double rand_double(double a, double b) {
-    return a + (double) rd() / rd.max() * (b - a);
-  }
-
-  static int rand_int(int a, int b) {
-    return (int) (a + rd() % (b - a + 1));
-  }
-
-};
-
-}
-#endif
-
 #endif //CODEBALL_CONSTANTS_H
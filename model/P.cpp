@@ -8,14 +8,3 @@
 std::vector<P::Line> P::lines_to_draw;
 std::vector<P::Sphere> P::spheres_to_draw;
 std::vector<std::string>  P::logs;
-
-
-#ifndef LOCAL
-namespace Frozen {
-
-std::vector<P::Line> P::lines_to_draw;
-std::vector<P::Sphere> P::spheres_to_draw;
-std::vector<std::string>  P::logs;
-
-}
-#endif
\ No newline at end of file
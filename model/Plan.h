@@ -1,134 +1,163 @@
 #ifndef CODEBALL_PLAN_H
 #define CODEBALL_PLAN_H
 
-struct Plan {
-  double angle1;
-  double sangle1;
-  double cangle1;
-  double y1;
-  double cos_lat1;
-  double angle2;
-  double sangle2;
-  double cangle2;
-  double y2;
-  double cos_lat2;
-  double max_jump_speed;
-  double max_speed;
+// searched parameters of a plan, everything else in Plan is derived from them or filled by evaluation
+struct PlanGenome {
+  double angle1 = 0;
+  double y1 = 0;
+  double angle2 = 0;
+  double y2 = 0;
+  double speed1 = 1., speed2 = 1.;
+  double max_jump_speed = 0;
+  double max_speed = 0;
   int time_nitro_on = C::NEVER;
   int time_nitro_off = C::NEVER;
   int time_change = C::NEVER;
   int time_jump = C::NEVER;
-  int plans_config;
-  int unique_id;
-  int parent_id;
-  double speed1 = 1., speed2 = 1.;
+  int configuration = 0;
+  bool nitro_as_velocity = false, nitro_up = false;
+};
 
-  int oncoming_jump;
+// target velocities of both segments of a genome, the only thing toMyAction needs from angles
+struct CompiledPlan {
+  Point velocity1, velocity2;
+  Point nitro_velocity1, nitro_velocity2;
 
-  double oncoming_jump_speed;
+  CompiledPlan() {}
 
-  bool was_jumping;
-  bool was_on_ground_after_jumping;
-  bool collide_with_entity_before_on_ground_after_jumping;
+  explicit CompiledPlan(const PlanGenome& genome) {
+    const double& cangle1 = cos(genome.angle1);
+    const double& sangle1 = sin(genome.angle1);
+    const double& cangle2 = cos(genome.angle2);
+    const double& sangle2 = sin(genome.angle2);
+    const double& cos_lat1 = cos(asin(genome.y1 / C::rules.MAX_ENTITY_SPEED));
+    const double& cos_lat2 = cos(asin(genome.y2 / C::rules.MAX_ENTITY_SPEED));
 
-  Point crossing;
-  Point crossing2;
+    velocity1.x = genome.speed1 * genome.max_speed * cangle1;
+    velocity1.y = 0;
+    velocity1.z = genome.speed1 * genome.max_speed * sangle1;
 
-  int configuration;
+    velocity2.x = genome.speed2 * genome.max_speed * cangle2;
+    velocity2.y = 0;
+    velocity2.z = genome.speed2 * genome.max_speed * sangle2;
 
-  Point nitro_velocity1, nitro_velocity2;
-  Point velocity1, velocity2;
+    nitro_velocity1.x = genome.speed1 * 100 * cos_lat1 * cangle1;
+    nitro_velocity1.y = genome.y1;
+    nitro_velocity1.z = genome.speed1 * 100 * cos_lat1 * sangle1;
 
-  struct Score {
-    double sum_score;
-    double fighter_min_dist_to_ball;
-    double fighter_min_dist_to_goal;
-    double fighter_last_dist_to_goal;
-    double defender_min_dist_to_ball;
-    double defender_min_dist_from_goal;
-    double defender_last_dist_from_goal;
-    double fighter_closest_enemy_ever;
-    double fighter_closest_enemy_last;
-
-    bool operator<(const Score& other) const {
-      return score() < other.score();
-    }
+    nitro_velocity2.x = genome.speed2 * 100 * cos_lat2 * cangle2;
+    nitro_velocity2.y = genome.y2;
+    nitro_velocity2.z = genome.speed2 * 100 * cos_lat2 * sangle2;
+  }
+};
 
-    double score() const {
-      return
-          sum_score
-              - fighter_min_dist_to_ball
-              - fighter_min_dist_to_goal
-              - fighter_last_dist_to_goal
-              - defender_min_dist_to_ball
-              + defender_min_dist_from_goal
-              + defender_last_dist_from_goal
-              + fighter_closest_enemy_ever
-              + fighter_closest_enemy_last;
-    }
+// evaluation result of a plan, the bigger score() the better
+struct PlanScore {
+  double sum_score;
+  double fighter_min_dist_to_ball;
+  double fighter_min_dist_to_goal;
+  double fighter_last_dist_to_goal;
+  double defender_min_dist_to_ball;
+  double defender_min_dist_from_goal;
+  double defender_last_dist_from_goal;
+  double fighter_closest_enemy_ever;
+  double fighter_closest_enemy_last;
+
+  bool operator<(const PlanScore& other) const {
+    return score() < other.score();
+  }
 
-    void minimal() {
-      sum_score = -1e18;
-      fighter_min_dist_to_ball = 1e9;
-      fighter_min_dist_to_goal = 1e9;
-      fighter_last_dist_to_goal = 1e9;
-      defender_min_dist_to_ball = 1e9;
-      defender_min_dist_from_goal = 1e9;
-      defender_last_dist_from_goal = 1e9;
-      fighter_closest_enemy_ever = 1e9;
-      fighter_closest_enemy_last = 1e9;
-    }
+  double score() const {
+    return
+        sum_score
+            - fighter_min_dist_to_ball
+            - fighter_min_dist_to_goal
+            - fighter_last_dist_to_goal
+            - defender_min_dist_to_ball
+            + defender_min_dist_from_goal
+            + defender_last_dist_from_goal
+            + fighter_closest_enemy_ever
+            + fighter_closest_enemy_last;
+  }
 
-    void start_fighter() {
-      sum_score = 0;
-      fighter_min_dist_to_ball = 1e9;
-      fighter_min_dist_to_goal = 1e9;
-      fighter_last_dist_to_goal = 1e9;
-      defender_min_dist_to_ball = 0;
-      defender_min_dist_from_goal = 0;
-      defender_last_dist_from_goal = 0;
-      fighter_closest_enemy_ever = 1e9;
-      fighter_closest_enemy_last = 1e9;
-    }
+  void minimal() {
+    sum_score = -1e18;
+    fighter_min_dist_to_ball = 1e9;
+    fighter_min_dist_to_goal = 1e9;
+    fighter_last_dist_to_goal = 1e9;
+    defender_min_dist_to_ball = 1e9;
+    defender_min_dist_from_goal = 1e9;
+    defender_last_dist_from_goal = 1e9;
+    fighter_closest_enemy_ever = 1e9;
+    fighter_closest_enemy_last = 1e9;
+  }
 
-    void start_defender() {
-      sum_score = 0;
-      fighter_min_dist_to_ball = 0;
-      fighter_min_dist_to_goal = 0;
-      fighter_last_dist_to_goal = 0;
-      defender_min_dist_to_ball = 1e9;
-      defender_min_dist_from_goal = 1e9;
-      defender_last_dist_from_goal = 0;
-      fighter_closest_enemy_ever = 0;
-      fighter_closest_enemy_last = 0;
-    }
+  void start_fighter() {
+    sum_score = 0;
+    fighter_min_dist_to_ball = 1e9;
+    fighter_min_dist_to_goal = 1e9;
+    fighter_last_dist_to_goal = 1e9;
+    defender_min_dist_to_ball = 0;
+    defender_min_dist_from_goal = 0;
+    defender_last_dist_from_goal = 0;
+    fighter_closest_enemy_ever = 1e9;
+    fighter_closest_enemy_last = 1e9;
+  }
 
-  } score;
+  void start_defender() {
+    sum_score = 0;
+    fighter_min_dist_to_ball = 0;
+    fighter_min_dist_to_goal = 0;
+    fighter_last_dist_to_goal = 0;
+    defender_min_dist_to_ball = 1e9;
+    defender_min_dist_from_goal = 1e9;
+    defender_last_dist_from_goal = 0;
+    fighter_closest_enemy_ever = 0;
+    fighter_closest_enemy_last = 0;
+  }
 
-  Plan() {}
+};
 
-  bool nitro_as_velocity = false, nitro_up = false;
+// plan of a robot: genome, velocities compiled from it on the first toMyAction after a change, evaluation results
+struct Plan : PlanGenome {
+  using Score = PlanScore;
+
+  int plans_config;
+  int unique_id;
+  int parent_id;
+
+  int oncoming_jump;
+  double oncoming_jump_speed;
+
+  bool was_jumping;
+  bool was_on_ground_after_jumping;
+  bool collide_with_entity_before_on_ground_after_jumping;
+
+  Score score;
+
+  CompiledPlan compiled;
+  bool is_compiled = false;
+
+  Plan() {}
 
   void rand_angle1() {
     angle1 = C::rand_double(0, 2 * M_PI);
-    cangle1 = cos(angle1);
-    sangle1 = sin(angle1);
+    is_compiled = false;
   }
 
   void rand_angle2() {
     angle2 = C::rand_double(0, 2 * M_PI);
-    cangle2 = cos(angle2);
-    sangle2 = sin(angle2);
+    is_compiled = false;
   }
 
   void rand_y1() {
     y1 = C::rand_double(-C::rules.MAX_ENTITY_SPEED, C::rules.MAX_ENTITY_SPEED);
-    cos_lat1 = cos(asin(y1 / C::rules.MAX_ENTITY_SPEED));
+    is_compiled = false;
   }
 
   void rand_y2() {
     y2 = C::rand_double(-C::rules.MAX_ENTITY_SPEED, C::rules.MAX_ENTITY_SPEED);
-    cos_lat2 = cos(asin(y2 / C::rules.MAX_ENTITY_SPEED));
+    is_compiled = false;
   }
 
   void rand_time_change(int simulation_depth) {
@@ -140,6 +169,7 @@ struct Plan {
     if (C::rand_double(0, 1) < 0.01) {
       speed1 = 0;
     }
+    is_compiled = false;
   }
 
   void speed2_1_or_0() {
@@ -147,10 +177,12 @@ struct Plan {
     if (C::rand_double(0, 1) < 0.01) {
       speed2 = 0;
     }
+    is_compiled = false;
   }
 
   void rand_speed1() {
     speed1 = C::rand_double(0, 1);
+    is_compiled = false;
   }
 
   void rand_time_jump(int simulation_depth, int start_at = 0) {
@@ -165,7 +197,8 @@ struct Plan {
        const double crossing_z = 0,
        const Point& nitro_acceleration = {0, 0, 0},
        const double jump_speed = 0,
-       const bool is_dribler = false) : configuration(configuration) {
+       const bool is_dribler = false) {
+    this->configuration = configuration;
     unique_id = C::unique_plan_id++;
     parent_id = unique_id;
 
@@ -258,44 +291,33 @@ struct Plan {
       //rand_speed1();
       max_jump_speed = 15;
       max_speed = C::rules.ROBOT_MAX_GROUND_SPEED;
-    } else if (configuration == 71) { // last action
+    } else if (configuration == 71 || configuration == 73) { // last action, opponent model
       if (!is_dribler) {
 
         angle1 = atan2(initial_vz, initial_vx);
-        cangle1 = cos(angle1);
-        sangle1 = sin(angle1);
 
         max_speed = Point2d{initial_vx, initial_vz}.length();
         max_jump_speed = (jump_speed == 0) ? 15 : jump_speed;
       } else {
         angle1 = 0;
-        cangle1 = cos(angle1);
-        sangle1 = sin(angle1);
         max_speed = 0;
         max_jump_speed = 0;
       }
-    } else if (configuration == 710) { // last action 0
+    } else if (configuration == 710 || configuration == 730) { // last action 0, opponent model 0
       if (!is_dribler) {
         angle1 = atan2(initial_vz, initial_vx);
-        cangle1 = cos(angle1);
-        sangle1 = sin(angle1);
 
         max_speed = Point2d{initial_vx, initial_vz}.length();
         max_jump_speed = 0;
       } else {
 
         angle1 = 0;
-        cangle1 = cos(angle1);
-        sangle1 = sin(angle1);
         max_speed = 0;
         max_jump_speed = 0;
       }
     } else if (configuration == 72) { // last action nitro
       angle1 = atan2(nitro_acceleration.z, nitro_acceleration.x);
-      cangle1 = cos(angle1);
-      sangle1 = sin(angle1);
       y1 = nitro_acceleration.y;
-      cos_lat1 = cos(asin(y1 / 100.));
 
       max_speed = 100.;
       max_jump_speed = (jump_speed == 0) ? 15 : jump_speed;
@@ -304,10 +326,7 @@ struct Plan {
       time_nitro_off = simulation_depth;
     } else if (configuration == 720) { // last action nitro 0
       angle1 = atan2(nitro_acceleration.z, nitro_acceleration.x);
-      cangle1 = cos(angle1);
-      sangle1 = sin(angle1);
       y1 = nitro_acceleration.y;
-      cos_lat1 = cos(asin(y1 / 100.));
 
       max_speed = 100.;
       max_jump_speed = 0;
@@ -316,27 +335,45 @@ struct Plan {
       time_nitro_off = simulation_depth;
     }
 
-    calcVelocities();
-
     score.minimal();
   }
 
-  inline void calcVelocities() {
-    velocity1.x = speed1 * max_speed * cangle1;
-    velocity1.y = 0;
-    velocity1.z = speed1 * max_speed * sangle1;
-
-    velocity2.x = speed2 * max_speed * cangle2;
-    velocity2.y = 0;
-    velocity2.z = speed2 * max_speed * sangle2;
+  void compile() {
+    compiled = CompiledPlan(*this);
+    is_compiled = true;
+  }
 
-    nitro_velocity1.x = speed1 * 100 * cos_lat1 * cangle1;
-    nitro_velocity1.y = y1;
-    nitro_velocity1.z = speed1 * 100 * cos_lat1 * sangle1;
+  static uint64_t mixKey(const uint64_t& key, const long long& value) {
+    return key ^ ((uint64_t) value + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
+  }
 
-    nitro_velocity2.x = speed2 * 100 * cos_lat2 * cangle2;
-    nitro_velocity2.y = y2;
-    nitro_velocity2.z = speed2 * 100 * cos_lat2 * sangle2;
+  // quantized parameters which define actions of the plan, velocities of the second segment only if it exists
+  uint64_t genomeKey() const {
+    const auto& velocity = [](const double& x) { return llround(x / C::EVAL_CACHE_VELOCITY_STEP); };
+    const CompiledPlan& compiled = is_compiled ? this->compiled : CompiledPlan(*this);
+    const Point& velocity1 = compiled.velocity1;
+    const Point& velocity2 = compiled.velocity2;
+    const Point& nitro_velocity1 = compiled.nitro_velocity1;
+    const Point& nitro_velocity2 = compiled.nitro_velocity2;
+    uint64_t key = mixKey(configuration, time_jump);
+    key = mixKey(key, time_nitro_on);
+    key = mixKey(key, time_nitro_off);
+    key = mixKey(key, nitro_up + 2 * nitro_as_velocity);
+    key = mixKey(key, llround(max_jump_speed / C::EVAL_CACHE_JUMP_STEP));
+    key = mixKey(key, velocity(velocity1.x));
+    key = mixKey(key, velocity(velocity1.z));
+    key = mixKey(key, velocity(nitro_velocity1.x));
+    key = mixKey(key, velocity(nitro_velocity1.y));
+    key = mixKey(key, velocity(nitro_velocity1.z));
+    key = mixKey(key, time_change);
+    if (time_change != C::NEVER) {
+      key = mixKey(key, velocity(velocity2.x));
+      key = mixKey(key, velocity(velocity2.z));
+      key = mixKey(key, velocity(nitro_velocity2.x));
+      key = mixKey(key, velocity(nitro_velocity2.y));
+      key = mixKey(key, velocity(nitro_velocity2.z));
+    }
+    return key;
   }
 
   static constexpr double angle_mutation = M_PI / 100;
@@ -357,8 +394,7 @@ struct Plan {
     if (angle1 < 0) {
       angle1 += 2 * M_PI;
     }
-    cangle1 = cos(angle1);
-    sangle1 = sin(angle1);
+    is_compiled = false;
   }
 
   void mutate_angle2() {
@@ -369,8 +405,7 @@ struct Plan {
     if (angle2 < 0) {
       angle2 += 2 * M_PI;
     }
-    cangle2 = cos(angle2);
-    sangle2 = sin(angle2);
+    is_compiled = false;
   }
 
   void mutate_y1() {
@@ -380,7 +415,7 @@ struct Plan {
     } else if (y1 < -C::rules.MAX_ENTITY_SPEED) {
       y1 = -C::rules.MAX_ENTITY_SPEED;
     }
-    cos_lat1 = cos(asin(y1 / C::rules.MAX_ENTITY_SPEED));
+    is_compiled = false;
   }
 
   void mutate_y2() {
@@ -390,7 +425,7 @@ struct Plan {
     } else if (y2 < -C::rules.MAX_ENTITY_SPEED) {
       y2 = -C::rules.MAX_ENTITY_SPEED;
     }
-    cos_lat2 = cos(asin(y2 / C::rules.MAX_ENTITY_SPEED));
+    is_compiled = false;
   }
 
   void mutate_time_change(int simulation_depth) {
@@ -436,6 +471,7 @@ struct Plan {
     if (speed1 < 0) {
       speed1 = 0;
     }
+    is_compiled = false;
   }
   void mutate_speed2() {
     speed2 += C::rand_double(-speed_mutation, speed_mutation);
@@ -445,6 +481,7 @@ struct Plan {
     if (speed2 < 0) {
       speed2 = 0;
     }
+    is_compiled = false;
   }
 
   void mutate(int configuration, const int simulation_depth) {
@@ -507,17 +544,32 @@ struct Plan {
       mutate_jump_speed();
     }
 
-    calcVelocities();
     score.minimal();
   }
 
-  void clearAndShift(const int simulation_depth) {
+  // forget results of previous evaluation, keep plan parameters
+  void clearEvaluation() {
     score.minimal();
 
     was_jumping = false;
     was_on_ground_after_jumping = false;
     collide_with_entity_before_on_ground_after_jumping = false;
     oncoming_jump = C::NEVER;
+  }
+
+  // evaluation so far of a plan with the same prefix, tree search continues it with own second segment
+  void takeEvaluation(const Plan& other) {
+    score = other.score;
+    plans_config = other.plans_config;
+    was_jumping = other.was_jumping;
+    was_on_ground_after_jumping = other.was_on_ground_after_jumping;
+    collide_with_entity_before_on_ground_after_jumping = other.collide_with_entity_before_on_ground_after_jumping;
+    oncoming_jump = other.oncoming_jump;
+    oncoming_jump_speed = other.oncoming_jump_speed;
+  }
+
+  void clearAndShift(const int simulation_depth) {
+    clearEvaluation();
 
     if (time_jump != C::NEVER) {
       time_jump--;
@@ -530,14 +582,10 @@ struct Plan {
       if (time_change < 0) {
         time_change = C::NEVER;
         std::swap(angle1, angle2);
-        std::swap(sangle1, sangle2);
-        std::swap(cangle1, cangle2);
         std::swap(y1, y2);
-        std::swap(cos_lat1, cos_lat2);
         std::swap(speed1, speed2);
-        std::swap(crossing, crossing2);
-        std::swap(velocity1, velocity2);
-        std::swap(nitro_velocity1, nitro_velocity2);
+        std::swap(compiled.velocity1, compiled.velocity2);
+        std::swap(compiled.nitro_velocity1, compiled.nitro_velocity2);
       }
     }
     if (time_nitro_on != C::NEVER && time_nitro_off != C::NEVER) {
@@ -555,6 +603,9 @@ struct Plan {
   }
 
   inline MyAction toMyAction(const int& simulation_tick, const bool& simulation, const bool& can_use_nitro, const Point& position, const Point& velocity) {
+    if (!is_compiled) {
+      compile();
+    }
     const double& jump_speed = simulation ? (simulation_tick == time_jump ? max_jump_speed : 0) : (simulation_tick == oncoming_jump ? oncoming_jump_speed : 0);
     const bool& now_use_nitro = can_use_nitro && simulation_tick >= time_nitro_on && simulation_tick < time_nitro_off;
     if (now_use_nitro) {
@@ -573,13 +624,13 @@ struct Plan {
             now_use_nitro};
       } else {
         if (simulation_tick < time_change) {
-          return MyAction{nitro_velocity1,
+          return MyAction{compiled.nitro_velocity1,
               jump_speed,
               max_jump_speed,
               now_use_nitro};
 
         } else {
-          return MyAction{nitro_velocity2,
+          return MyAction{compiled.nitro_velocity2,
               jump_speed,
               max_jump_speed,
               now_use_nitro};
@@ -587,12 +638,12 @@ struct Plan {
       }
     } else {
       if (simulation_tick < time_change) {
-        return MyAction{velocity1,
+        return MyAction{compiled.velocity1,
             jump_speed,
             max_jump_speed,
             now_use_nitro};
       } else {
-        return MyAction{velocity2,
+        return MyAction{compiled.velocity2,
             jump_speed,
             max_jump_speed,
             now_use_nitro};
@@ -604,625 +655,46 @@ struct Plan {
   }
 };
 
-#ifndef LOCAL
-namespace Frozen {
-
-struct Plan {
-  double angle1;
-  double sangle1;
-  double cangle1;
-  double y1;
-  double cos_lat1;
-  double angle2;
-  double sangle2;
-  double cangle2;
-  double y2;
-  double cos_lat2;
-  double max_jump_speed;
-  double max_speed;
+// everything evaluation changes in a plan, entry of evaluation cache
+struct PlanEvaluation {
+  uint64_t world = 0; // ids of simulators the plan was evaluated with, 0 - empty entry
+  uint64_t key;
+  Plan::Score score;
+  int plans_config;
+  int time_jump;
   int time_nitro_on;
   int time_nitro_off;
-  int time_change;
-  int time_jump;
-  int plans_config;
-  int unique_id;
-  int parent_id;
-  double speed1, speed2;
-
   int oncoming_jump;
-
   double oncoming_jump_speed;
-
   bool was_jumping;
   bool was_on_ground_after_jumping;
   bool collide_with_entity_before_on_ground_after_jumping;
 
-  Point crossing;
-  Point crossing2;
-
-  int configuration;
-
-  struct Score {
-    double sum_score;
-    double fighter_min_dist_to_ball;
-    double fighter_min_dist_to_goal;
-    double fighter_last_dist_to_goal;
-    double defender_min_dist_to_ball;
-    double defender_min_dist_from_goal;
-    double defender_last_dist_from_goal;
-
-    bool operator<(const Score& other) const {
-      return score() < other.score();
-    }
-
-    double score() const {
-      return
-          sum_score
-              - fighter_min_dist_to_ball
-              - fighter_min_dist_to_goal
-              - fighter_last_dist_to_goal
-              - defender_min_dist_to_ball
-              + defender_min_dist_from_goal
-              + defender_last_dist_from_goal;
-    }
-
-    void minimal() {
-      sum_score = -1e18;
-      fighter_min_dist_to_ball = 1e9;
-      fighter_min_dist_to_goal = 1e9;
-      fighter_last_dist_to_goal = 1e9;
-      defender_min_dist_to_ball = 1e9;
-      defender_min_dist_from_goal = 1e9;
-      defender_last_dist_from_goal = 1e9;
-    }
-
-    void start_fighter() {
-      sum_score = 0;
-      fighter_min_dist_to_ball = 1e9;
-      fighter_min_dist_to_goal = 1e9;
-      fighter_last_dist_to_goal = 1e9;
-      defender_min_dist_to_ball = 0;
-      defender_min_dist_from_goal = 0;
-      defender_last_dist_from_goal = 0;
-    }
-
-    void start_defender() {
-      sum_score = 0;
-      fighter_min_dist_to_ball = 0;
-      fighter_min_dist_to_goal = 0;
-      fighter_last_dist_to_goal = 0;
-      defender_min_dist_to_ball = 1e9;
-      defender_min_dist_from_goal = 1e9;
-      defender_last_dist_from_goal = 0;
-    }
-
-  } score;
-  Plan() : Plan(3, 0) {}
-
-  Plan(int configuration,
-       const int simulation_depth,
-       const double initial_vx = 0,
-       const double initial_vz = 0,
-       const double crossing_x = 0,
-       const double crossing_z = 0) : configuration(configuration) {
-    unique_id = C::unique_plan_id++;
-    parent_id = unique_id;
-
-    was_jumping = false;
-    was_on_ground_after_jumping = false;
-    collide_with_entity_before_on_ground_after_jumping = false;
-    oncoming_jump = C::NEVER;
-
-    if (configuration == 1) {
-      angle1 = C::rand_double(0, 2 * M_PI);
-      cangle1 = cos(angle1);
-      sangle1 = sin(angle1);
-      y1 = C::rand_double(-C::rules.MAX_ENTITY_SPEED, C::rules.MAX_ENTITY_SPEED);
-      cos_lat1 = cos(asin(y1 / C::rules.MAX_ENTITY_SPEED));
-      angle2 = C::rand_double(0, 2 * M_PI);
-      cangle2 = cos(angle2);
-      sangle2 = sin(angle2);
-      y2 = C::rand_double(-C::rules.MAX_ENTITY_SPEED, C::rules.MAX_ENTITY_SPEED);
-      cos_lat2 = cos(asin(y2 / C::rules.MAX_ENTITY_SPEED));
-
-      time_change = C::rand_int(0, simulation_depth);
-      time_jump = C::rand_int(0, simulation_depth);
-
-      speed1 = speed2 = 1;
-      if (C::rand_double(0, 1) < 0.01) {
-        speed1 = 0;
-      }
-      if (C::rand_double(0, 1) < 0.01) {
-        speed2 = 0;
-      }
-
-      max_speed = C::rules.ROBOT_MAX_GROUND_SPEED;
-
-      max_jump_speed = C::rand_int(0, 15);
-
-      time_nitro_on = C::rand_int(0, simulation_depth);
-      time_nitro_off = C::rand_int(0, simulation_depth);
-
-    } else if (configuration == 2) { // smart enemy
-      angle1 = C::rand_double(0, 2 * M_PI);
-      cangle1 = cos(angle1);
-      sangle1 = sin(angle1);
-      time_change = C::NEVER;
-      time_jump = C::rand_int(0, simulation_depth);
-      speed1 = 1.;
-      max_speed = C::rules.ROBOT_MAX_GROUND_SPEED;
-      max_jump_speed = 15;
-      time_nitro_on = C::NEVER;
-      time_nitro_off = C::NEVER;
-    } else if (configuration == 3) { // sptupid enemy
-      angle1 = 0;
-      cangle1 = 0;
-      sangle1 = 0;
-      time_change = C::NEVER;
-      time_jump = C::NEVER;
-      speed1 = 0;
-      max_speed = C::rules.ROBOT_MAX_GROUND_SPEED;
-      max_jump_speed = 0; // todo keep in mind
-      time_nitro_on = C::NEVER;
-      time_nitro_off = C::NEVER;
-    } else if (configuration == 4) { // last action
-      angle1 = atan2(initial_vz, initial_vx);
-      cangle1 = cos(angle1);
-      sangle1 = sin(angle1);
-      time_change = C::NEVER;
-      time_jump = C::NEVER;
-      speed1 = 1;
-      max_speed = Point2d{initial_vx, initial_vz}.length();
-      max_jump_speed = 15;  // todo keep in mind
-      // todo last action nitro
-      time_nitro_on = C::NEVER;
-      time_nitro_off = C::NEVER;
-    } else if (configuration == 5) {
-      time_change = C::NEVER;
-      time_jump = C::NEVER;
-      speed1 = 1;
-      max_speed = Point2d{initial_vx, initial_vz}.length();
-      crossing = Point{crossing_x, 1, crossing_z};
-      max_jump_speed = 15;  // todo keep in mind
-      // todo last action nitro
-      time_nitro_on = C::NEVER;
-      time_nitro_off = C::NEVER;
-    } else if (configuration == 6) {
-
-      crossing = {C::rand_double(-30, 30), C::rand_double(0, 20), C::rand_double(-50, 50)};
-
-      time_change = C::NEVER;
-      time_jump = C::rand_int(0, simulation_depth);
-
-      speed1 = 1;
-      if (C::rand_double(0, 1) < 0.01) {
-        speed1 = 0;
-      }
-
-      max_speed = C::rules.ROBOT_MAX_GROUND_SPEED;
-
-      max_jump_speed = C::rand_int(0, 15);
-      time_nitro_on = C::rand_int(0, simulation_depth);
-      time_nitro_off = C::rand_int(0, simulation_depth);
-    } else if (configuration == 7) {
-
-      crossing = {C::rand_double(-30, 30), C::rand_double(0, 20), C::rand_double(-50, 50)};
-
-      crossing2 = {C::rand_double(-30, 30), C::rand_double(0, 20), C::rand_double(-50, 50)};
-
-      time_change = C::rand_int(0, simulation_depth);
-      time_jump = C::rand_int(0, simulation_depth);
-
-      speed1 = C::rand_double(0, 1);
-      speed2 = C::rand_double(0, 1);
-      //if (C::rand_double(0, 1) < 0.01) {
-      //  speed1 = 0;
-      //}
-      //if (C::rand_double(0, 1) < 0.01) {
-      //  speed2 = 0;
-      //}
-
-      max_speed = C::rules.ROBOT_MAX_GROUND_SPEED;
-
-      max_jump_speed = C::rand_int(0, 15);
-      time_nitro_on = C::rand_int(0, simulation_depth);
-      time_nitro_off = C::rand_int(0, simulation_depth);
-    }
-
-    score.minimal();
-  }
-
-  static constexpr double angle_mutation = M_PI / 100;
-  static constexpr double speed_mutation = 0.05;
-  static constexpr double z_mutation = 1;
-  static constexpr double crossing_mutation = 1;
-
-  static constexpr int nitro_mutation = 1;
-  static constexpr int jump_mutation = 1;
-  static constexpr int time_mutation = 1;
-
-  void mutate(int configuration, const int simulation_depth) {
-    unique_id = C::unique_plan_id++;
-
-    was_jumping = false;
-    was_on_ground_after_jumping = false;
-    collide_with_entity_before_on_ground_after_jumping = false;
-    oncoming_jump = C::NEVER;
-
-    if (configuration == 1) {
-      angle1 += C::rand_double(-angle_mutation, angle_mutation);
-      if (angle1 > 2 * M_PI) {
-        angle1 -= 2 * M_PI;
-      }
-      if (angle1 < 0) {
-        angle1 += 2 * M_PI;
-      }
-      cangle1 = cos(angle1);
-      sangle1 = sin(angle1);
-      angle2 += C::rand_double(-angle_mutation, angle_mutation);
-      if (angle2 > 2 * M_PI) {
-        angle2 -= 2 * M_PI;
-      }
-      if (angle2 < 0) {
-        angle2 += 2 * M_PI;
-      }
-      cangle2 = cos(angle2);
-      sangle2 = sin(angle2);
-
-      y1 += C::rand_double(-z_mutation, z_mutation);
-      if (y1 > C::rules.MAX_ENTITY_SPEED) {
-        y1 = C::rules.MAX_ENTITY_SPEED;
-      } else if (y1 < -C::rules.MAX_ENTITY_SPEED) {
-        y1 = -C::rules.MAX_ENTITY_SPEED;
-      }
-      cos_lat1 = cos(asin(y1 / C::rules.MAX_ENTITY_SPEED));
-
-      y2 += C::rand_double(-z_mutation, z_mutation);
-      if (y2 > C::rules.MAX_ENTITY_SPEED) {
-        y2 = C::rules.MAX_ENTITY_SPEED;
-      } else if (y2 < -C::rules.MAX_ENTITY_SPEED) {
-        y2 = -C::rules.MAX_ENTITY_SPEED;
-      }
-      cos_lat2 = cos(asin(y2 / C::rules.MAX_ENTITY_SPEED));
-
-      if (time_change != C::NEVER) {
-        time_change += C::rand_int(-time_mutation, time_mutation);
-        if (time_change < 0) {
-          time_change = 0;
-        }
-        if (time_change > simulation_depth) {
-          time_change = simulation_depth;
-        }
-      }
-      if (time_jump != C::NEVER) {
-        time_jump += C::rand_int(-time_mutation, time_mutation);
-        if (time_jump < 0) {
-          time_jump = 0;
-        }
-        if (time_jump > simulation_depth) {
-          time_jump = simulation_depth;
-        }
-      }
-
-      /*speed1 += C::rand_double(-speed_mutation, speed_mutation); // todo change speed mutation
-      if (speed1 > 1) {
-        speed1 = 1;
-      }
-      if (speed1 < 0) {
-        speed1 = 0;
-      }
-
-      speed2 += C::rand_double(-speed_mutation, speed_mutation);
-      if (speed2 > 1) {
-        speed2 = 1;
-      }
-      if (speed2 < 0) {
-        speed2 = 0;
-      }*/
-
-      max_jump_speed += C::rand_int(-jump_mutation, jump_mutation);
-      if (max_jump_speed < 0) {
-        max_jump_speed = 0;
-      }
-      if (max_jump_speed > 15) {
-        max_jump_speed = 15;
-      }
-
-      if (time_nitro_on != C::NEVER) {
-        time_nitro_on += C::rand_int(-nitro_mutation, nitro_mutation);
-        if (time_nitro_on < 0) {
-          time_nitro_on = 0;
-        }
-        if (time_nitro_on > simulation_depth) {
-          time_nitro_on = simulation_depth;
-        }
-      }
-      if (time_nitro_off != C::NEVER) {
-        time_nitro_off += C::rand_int(-nitro_mutation, nitro_mutation);
-        if (time_nitro_off < 0) {
-          time_nitro_off = 0;
-        }
-        if (time_nitro_off > simulation_depth) {
-          time_nitro_off = simulation_depth;
-        }
-      }
-    } else if (configuration == 2) { // smart enemy
-      angle1 += C::rand_double(-angle_mutation, angle_mutation);
-      if (angle1 > 2 * M_PI) {
-        angle1 -= 2 * M_PI;
-      }
-      if (angle1 < 0) {
-        angle1 += 2 * M_PI;
-      }
-      cangle1 = cos(angle1);
-      sangle1 = sin(angle1);
-
-      if (time_jump != C::NEVER) {
-        time_jump += C::rand_int(-time_mutation, time_mutation);
-        if (time_jump < 0) {
-          time_jump = 0;
-        }
-        if (time_jump > simulation_depth) {
-          time_jump = simulation_depth;
-        }
-      }
-
-    } else if (configuration == 6) {
-      crossing.x += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing.x > 30) {
-        crossing.x = 30;
-      } else if (crossing.x < -30) {
-        crossing.x = -30;
-      }
-
-      crossing.y += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing.y > 20) {
-        crossing.y = 20;
-      } else if (crossing.y < 0) {
-        crossing.y = 0;
-      }
-
-      crossing.z += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing.z > 50) {
-        crossing.z = 50;
-      } else if (crossing.z < -50) {
-        crossing.z = -50;
-      }
-
-      if (time_jump != C::NEVER) {
-        time_jump += C::rand_int(-time_mutation, time_mutation);
-        if (time_jump < 0) {
-          time_jump = 0;
-        }
-        if (time_jump > simulation_depth) {
-          time_jump = simulation_depth;
-        }
-      }
-
-      max_jump_speed += C::rand_int(-jump_mutation, jump_mutation);
-      if (max_jump_speed < 0) {
-        max_jump_speed = 0;
-      }
-      if (max_jump_speed > 15) {
-        max_jump_speed = 15;
-      }
-
-    } else if (configuration == 7) {
-
-      crossing.x += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing.x > 30) {
-        crossing.x = 30;
-      } else if (crossing.x < -30) {
-        crossing.x = -30;
-      }
-
-      crossing.y += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing.y > 20) {
-        crossing.y = 20;
-      } else if (crossing.y < 0) {
-        crossing.y = 0;
-      }
-
-      crossing.z += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing.z > 50) {
-        crossing.z = 50;
-      } else if (crossing.z < -50) {
-        crossing.z = -50;
-      }
-
-      crossing2.x += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing2.x > 30) {
-        crossing2.x = 30;
-      } else if (crossing2.x < -30) {
-        crossing2.x = -30;
-      }
-
-      crossing2.y += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing2.y > 20) {
-        crossing2.y = 20;
-      } else if (crossing2.y < 0) {
-        crossing2.y = 0;
-      }
-
-      crossing2.z += C::rand_double(-crossing_mutation, crossing_mutation);
-      if (crossing2.z > 50) {
-        crossing2.z = 50;
-      } else if (crossing2.z < -50) {
-        crossing2.z = -50;
-      }
-
-      if (time_change != C::NEVER) {
-        time_change += C::rand_int(-time_mutation, time_mutation);
-        if (time_change < 0) {
-          time_change = 0;
-        }
-        if (time_change > simulation_depth) {
-          time_change = simulation_depth;
-        }
-      }
-
-      if (time_jump != C::NEVER) {
-        time_jump += C::rand_int(-time_mutation, time_mutation);
-        if (time_jump < 0) {
-          time_jump = 0;
-        }
-        if (time_jump > simulation_depth) {
-          time_jump = simulation_depth;
-        }
-      }
-
-      speed1 += C::rand_double(-speed_mutation, speed_mutation); // todo change speed mutation
-      if (speed1 > 1) {
-        speed1 = 1;
-      }
-      if (speed1 < 0) {
-        speed1 = 0;
-      }
-
-      speed2 += C::rand_double(-speed_mutation, speed_mutation);
-      if (speed2 > 1) {
-        speed2 = 1;
-      }
-      if (speed2 < 0) {
-        speed2 = 0;
-      }
-
-      max_jump_speed += C::rand_int(-jump_mutation, jump_mutation);
-      if (max_jump_speed < 0) {
-        max_jump_speed = 0;
-      }
-      if (max_jump_speed > 15) {
-        max_jump_speed = 15;
-      }
-
-      if (time_nitro_on != C::NEVER) {
-
-        time_nitro_on += C::rand_int(-nitro_mutation, nitro_mutation);
-        if (time_nitro_on < 0) {
-          time_nitro_on = 0;
-        }
-        if (time_nitro_on > simulation_depth) {
-          time_nitro_on = simulation_depth;
-        }
-      }
-
-      if (time_nitro_off != C::NEVER) {
-
-        time_nitro_off += C::rand_int(-nitro_mutation, nitro_mutation);
-        if (time_nitro_off < 0) {
-          time_nitro_off = 0;
-        }
-        if (time_nitro_off > simulation_depth) {
-          time_nitro_off = simulation_depth;
-        }
-      }
-
-    }
-
-    score.minimal();
+  void take(const Plan& plan) {
+    score = plan.score;
+    plans_config = plan.plans_config;
+    time_jump = plan.time_jump;
+    time_nitro_on = plan.time_nitro_on;
+    time_nitro_off = plan.time_nitro_off;
+    oncoming_jump = plan.oncoming_jump;
+    oncoming_jump_speed = plan.oncoming_jump_speed;
+    was_jumping = plan.was_jumping;
+    was_on_ground_after_jumping = plan.was_on_ground_after_jumping;
+    collide_with_entity_before_on_ground_after_jumping = plan.collide_with_entity_before_on_ground_after_jumping;
   }
 
-  void clearAndShift(const int simulation_depth) {
-    score.minimal();
-
-    was_jumping = false;
-    was_on_ground_after_jumping = false;
-    collide_with_entity_before_on_ground_after_jumping = false;
-    oncoming_jump = C::NEVER;
-
-    if (time_jump != C::NEVER) {
-      time_jump--;
-      if (time_jump < 0) {
-        time_jump = C::NEVER;
-      }
-    }
-    if (time_change != C::NEVER) {
-      time_change--;
-      if (time_change < 0) {
-        time_change = C::NEVER;
-        std::swap(angle1, angle2);
-        std::swap(sangle1, sangle2);
-        std::swap(cangle1, cangle2);
-        std::swap(y1, y2);
-        std::swap(cos_lat1, cos_lat2);
-        std::swap(speed1, speed2);
-        std::swap(crossing, crossing2);
-      }
-    }
-    if (time_nitro_on != C::NEVER && time_nitro_off != C::NEVER) {
-      time_nitro_on--;
-      time_nitro_off--;
-      if (time_nitro_on < 0 && time_nitro_off < 0) {
-        time_nitro_on = C::NEVER;
-        time_nitro_off = C::NEVER;
-      } else if (time_nitro_on < 0) {
-        time_nitro_on = 0;
-      } else {
-        time_nitro_off = 0;
-      }
-    }
-  }
-
-  MyAction toMyAction(int simulation_tick, bool simulation, bool can_use_nitro, const Point& position) {
-    double jump_speed;
-    if (simulation) {
-      jump_speed = simulation_tick == time_jump ? max_jump_speed : 0;
-    } else {
-      jump_speed = simulation_tick == oncoming_jump ? oncoming_jump_speed : 0;
-    }
-    bool now_use_nitro = (simulation_tick >= time_nitro_on && simulation_tick < time_nitro_off);
-    Point velocity;
-    if (now_use_nitro && can_use_nitro) {
-      if (simulation_tick < time_change) {
-        if (configuration != 7) {
-          velocity.x = speed1 * C::rules.MAX_ENTITY_SPEED * cos_lat1 * cangle1;
-          velocity.y = y1;
-          velocity.z = speed1 * C::rules.MAX_ENTITY_SPEED * cos_lat1 * sangle1;
-        } else {
-          velocity = (crossing - position).normalize() * (speed1 * C::rules.MAX_ENTITY_SPEED);
-        }
-      } else {
-        if (configuration != 7) {
-          velocity.x = speed2 * C::rules.MAX_ENTITY_SPEED * cos_lat2 * cangle2;
-          velocity.y = y2;
-          velocity.z = speed2 * C::rules.MAX_ENTITY_SPEED * cos_lat2 * sangle2;
-        } else {
-          velocity = (crossing2 - position).normalize() * (speed2 * C::rules.MAX_ENTITY_SPEED);
-        }
-      }
-    } else {
-      if (simulation_tick < time_change) {
-        if (configuration != 5 && configuration != 6 && configuration != 7) {
-          velocity.x = speed1 * max_speed * cangle1;
-          velocity.y = 0;
-          velocity.z = speed1 * max_speed * sangle1;
-        } else {
-          Point p = (crossing - position);
-          p.y = 0;
-          velocity = p.normalize() * (speed1 * max_speed);
-        }
-      } else {
-        if (configuration != 7) {
-          velocity.x = speed2 * max_speed * cangle2;
-          velocity.y = 0;
-          velocity.z = speed2 * max_speed * sangle2;
-        } else {
-          Point p = (crossing2 - position);
-          p.y = 0;
-          velocity = p.normalize() * (speed2 * max_speed);
-        }
-      }
-    }
-    return MyAction{velocity,
-        jump_speed,
-        max_jump_speed,
-        (now_use_nitro && can_use_nitro)};
-  }
-  bool operator<(const Plan& other) const {
-    return score < other.score;
+  void applyTo(Plan& plan) const {
+    plan.score = score;
+    plan.plans_config = plans_config;
+    plan.time_jump = time_jump;
+    plan.time_nitro_on = time_nitro_on;
+    plan.time_nitro_off = time_nitro_off;
+    plan.oncoming_jump = oncoming_jump;
+    plan.oncoming_jump_speed = oncoming_jump_speed;
+    plan.was_jumping = was_jumping;
+    plan.was_on_ground_after_jumping = was_on_ground_after_jumping;
+    plan.collide_with_entity_before_on_ground_after_jumping = collide_with_entity_before_on_ground_after_jumping;
   }
 };
 
-}
-#endif
 #endif //CODEBALL_PLAN_H
@@ -0,0 +1,63 @@
+#ifdef LOCAL
+#include <model/Profiler.h>
+#else
+#include "Profiler.h"
+#endif
+
+#ifdef PROFILE
+
+#include <cstdio>
+
+const char* Profiler::names[Profiler::ZONES_COUNT] = {
+    "strategy",
+    "enemiesPrediction",
+    "search",
+    "scoring",
+    "simulatorPrecompute",
+    "tickDynamic",
+    "tickDihaBisection",
+    "updateDynamic",
+    "collideWithArenaDynamic"
+};
+Profiler::Stats Profiler::stats[Profiler::ZONES_COUNT];
+uint64_t Profiler::children[Profiler::MAX_DEPTH + 1];
+int Profiler::depth = 0;
+int Profiler::ticks = 0;
+uint64_t Profiler::start_clock = Profiler::now();
+double Profiler::start_seconds = Profiler::seconds();
+
+void Profiler::endTick() {
+  for (auto& s : stats) {
+    if (s.tick_total > s.max_tick_total) {
+      s.max_tick_total = s.tick_total;
+    }
+    s.tick_total = 0;
+  }
+  ticks++;
+}
+
+void Profiler::dump() {
+  const double elapsed = seconds() - start_seconds;
+  const double seconds_per_clock = elapsed / double(now() - start_clock);
+  uint64_t measured = 0;
+  for (auto& s : stats) {
+    measured += s.self;
+  }
+  if (measured == 0) {
+    return;
+  }
+  printf("%-24s %10s %10s %8s %8s %10s\n", "zone", "total,s", "self,s", "self,%", "calls", "tick max,ms");
+  for (int i = 0; i < ZONES_COUNT; ++i) {
+    const auto& s = stats[i];
+    printf("%-24s %10.3f %10.3f %8.2f %8lld %10.3f\n",
+           names[i],
+           s.total * seconds_per_clock,
+           s.self * seconds_per_clock,
+           100. * s.self / measured,
+           (long long) s.calls,
+           s.max_tick_total * seconds_per_clock * 1000);
+  }
+  printf("ticks %d, measured %.3fs of %.3fs wall\n", ticks, measured * seconds_per_clock, elapsed);
+}
+
+#endif
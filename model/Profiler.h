@@ -0,0 +1,113 @@
+#ifndef CODEBALL_PROFILER_H
+#define CODEBALL_PROFILER_H
+
+// scoped zones profiler, exists only with PROFILE define
+// zone keeps inclusive and self (minus nested zones) time, per game and per tick max
+// PROFILE_ZONE(ZONE_NAME) at the start of a block measures till the end of it
+
+#ifdef PROFILE
+
+#include <cstdint>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_RDTSC
+#endif
+
+struct Profiler {
+
+  enum Zone {
+    STRATEGY,
+    ENEMIES_PREDICTION,
+    SEARCH,
+    SCORING,
+    SIMULATOR_PRECOMPUTE,
+    TICK_DYNAMIC,
+    TICK_DIHA_BISECTION,
+    UPDATE_DYNAMIC,
+    COLLIDE_ARENA_DYNAMIC,
+    ZONES_COUNT
+  };
+
+  struct Stats {
+    uint64_t total;
+    uint64_t self;
+    int64_t calls;
+    uint64_t tick_total;
+    uint64_t max_tick_total;
+  };
+
+  static constexpr int MAX_DEPTH = 32;
+
+  static const char* names[ZONES_COUNT];
+  static Stats stats[ZONES_COUNT];
+  static uint64_t children[MAX_DEPTH + 1]; // time of nested zones on every depth
+  static int depth;
+  static int ticks;
+
+  // clock of calibration, rdtsc is converted to seconds with it at dump
+  static uint64_t start_clock;
+  static double start_seconds;
+
+  static inline uint64_t now() {
+#ifdef PROFILER_RDTSC
+    return __rdtsc();
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+#endif
+  }
+
+  static inline double seconds() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+
+  static inline void enter() {
+    children[++depth] = 0;
+  }
+
+  static inline void leave(const Zone& zone, const uint64_t& elapsed) {
+    auto& s = stats[zone];
+    s.total += elapsed;
+    s.self += elapsed - children[depth];
+    s.tick_total += elapsed;
+    s.calls++;
+    children[--depth] += elapsed;
+  }
+
+  struct Scope {
+    const Zone zone;
+    const uint64_t start;
+
+    explicit Scope(const Zone zone) : zone(zone), start((enter(), now())) {}
+
+    ~Scope() {
+      leave(zone, now() - start);
+    }
+  };
+
+  // called on the first act of every tick
+  static void endTick();
+
+  // time share per zone for the whole game
+  static void dump();
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(zone) Profiler::Scope PROFILE_CONCAT(profiler_scope_, __LINE__)(Profiler::zone)
+#define PROFILE_END_TICK() Profiler::endTick()
+#define PROFILE_DUMP() Profiler::dump()
+
+#else
+
+#define PROFILE_ZONE(zone)
+#define PROFILE_END_TICK()
+#define PROFILE_DUMP()
+
+#endif
+
+#endif //CODEBALL_PROFILER_H
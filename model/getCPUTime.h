@@ -1,11 +1,24 @@
 #ifndef CODEBALL_GETCPUTIME_H
 #define CODEBALL_GETCPUTIME_H
 
+#ifdef SPECULATIVE
+#include <time.h>
+#endif
+
 struct CPUTime {
   static double getCPUTime() {
     clock_t cl = clock();
     return (double) cl / (double) CLOCKS_PER_SEC;
   }
+
+#ifdef SPECULATIVE
+  // calling thread only, clock() sums all threads of the process
+  static double getThreadCPUTime() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+  }
+#endif
 };
 
 #endif //CODEBALL_GETCPUTIME_H
@@ -0,0 +1,90 @@
+#!/bin/bash
+# profile-guided build of the strategy from its single-file bundle
+# pgo.sh <record>... , records are games saved with CODEBALL_RECORD=<file> CodeBall ...
+# 1. bundle makes $OUT/MyStrategy.cpp from the sources, the same file goes to submission
+# 2. instrumented replay of every record with fixed iteration counts trains the profile
+# 3. CodeBall and replay are rebuilt with the profile and LTO, replay hashes must match the plain build
+# 4. plain and PGO replays run with real time limits, iterations per tick are compared
+# environment: OUT (_pgo), CXX (g++), DEFINES (none, e.g. SPECULATIVE), RUNS (3) timed runs of every record per build
+set -e
+
+if [ $# -eq 0 ]; then
+  echo "usage: $0 <record>..." >&2
+  exit 1
+fi
+
+ROOT=$(cd "$(dirname "$0")" && pwd)
+OUT=$(mkdir -p "${OUT:-_pgo}" && cd "${OUT:-_pgo}" && pwd)
+CXX=${CXX:-g++}
+DEFINES=${DEFINES:-}
+RUNS=${RUNS:-3}
+RECORDS=()
+for record in "$@"; do
+  RECORDS+=("$(cd "$(dirname "$record")" && pwd)/$(basename "$record")")
+done
+
+FLAGS="-std=c++17 -O2 -I$ROOT -I$ROOT/RewindClient/csimplesocket/include -D_LINUX"
+for define in $DEFINES; do
+  FLAGS="$FLAGS -D$define"
+  BUNDLE_DEFINES="$BUNDLE_DEFINES -D $define"
+done
+
+cmake -S "$ROOT" -B "$OUT/build" -DCMAKE_BUILD_TYPE=Release > /dev/null
+cmake --build "$OUT/build" --target bundle csimplesocket -j"$(nproc)" > /dev/null
+SOCKET="$OUT/build/RewindClient/csimplesocket/libcsimplesocket.a"
+
+# contest package files (Runner, RemoteProcessClient, rapidjson, csimplesocket) are not bundled
+cd "$ROOT"
+"$OUT/build/bundle" -o "$OUT/MyStrategy.cpp" --keep rapidjson/ --keep csimplesocket/ $BUNDLE_DEFINES \
+    MyStrategy.cpp H.cpp Strategy.cpp BallTrajectory.cpp Telemetry.cpp OpponentModel.cpp FidelityMonitor.cpp \
+    model/ArenaGeometry.cpp model/Profiler.cpp model/C.cpp model/P.cpp model/Game.cpp
+cd "$OUT"
+
+# profile is matched by object path, so every stage compiles the bundle to the same MyStrategy.o
+echo "plain build"
+$CXX $FLAGS -c MyStrategy.cpp -o MyStrategy.o
+$CXX $FLAGS -c "$ROOT/Replay.cpp" -o Replay.o
+$CXX Replay.o MyStrategy.o -o replay_plain -lpthread
+
+echo "training"
+rm -rf profile
+$CXX $FLAGS -fprofile-generate="$OUT/profile" -fprofile-update=prefer-atomic -c MyStrategy.cpp -o MyStrategy.o
+$CXX -fprofile-generate="$OUT/profile" Replay.o MyStrategy.o -o replay_train -lpthread
+for record in "${RECORDS[@]}"; do
+  ./replay_train "$record" 2> /dev/null | tail -1
+done
+
+echo "PGO build"
+PGO_FLAGS="$FLAGS -flto=auto -fprofile-use=$OUT/profile -fprofile-correction"
+$CXX $PGO_FLAGS -c MyStrategy.cpp -o MyStrategy.o
+$CXX $FLAGS -flto=auto -c "$ROOT/Replay.cpp" -o Replay.lto.o
+$CXX $FLAGS -flto=auto -c "$ROOT/Runner.cpp" -o Runner.lto.o
+$CXX $FLAGS -flto=auto -c "$ROOT/RemoteProcessClient.cpp" -o RemoteProcessClient.lto.o
+$CXX -O2 -flto=auto Replay.lto.o MyStrategy.o -o replay_pgo -lpthread
+$CXX -O2 -flto=auto Runner.lto.o RemoteProcessClient.lto.o MyStrategy.o "$SOCKET" -o CodeBall -lpthread
+
+# PGO must not change decisions, only their speed
+for record in "${RECORDS[@]}"; do
+  plain=$(./replay_plain "$record" 2> /dev/null | tail -1)
+  pgo=$(./replay_pgo "$record" 2> /dev/null | tail -1)
+  if [ "$plain" != "$pgo" ]; then
+    echo "$record: plain build gives '$plain', PGO build '$pgo'" >&2
+    exit 1
+  fi
+done
+
+# builds alternate run by run, so load changes of the machine hit both
+echo "timed replays"
+rm -f timed_plain.txt timed_pgo.txt
+for run in $(seq "$RUNS"); do
+  for record in "${RECORDS[@]}"; do
+    for build in plain pgo; do
+      ./replay_$build "$record" --timed 2> /dev/null | tail -1 >> timed_$build.txt
+    done
+  done
+done
+plain=$(awk '{ sum += $1 } END { print sum / NR }' timed_plain.txt)
+pgo=$(awk '{ sum += $1 } END { print sum / NR }' timed_pgo.txt)
+awk -v plain="$plain" -v pgo="$pgo" \
+    'BEGIN { printf "iterations per tick: plain %.1f, PGO %.1f, speedup %.3f\n", plain, pgo, pgo / plain }'
+echo "bundle $OUT/MyStrategy.cpp, optimized bot $OUT/CodeBall"